@@ -8,6 +8,7 @@
 
 #include <string>
 #include <vector>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <algorithm>
@@ -17,6 +18,21 @@
 #include <csignal>
 #include <cassert>
 #include <cerrno>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <new>
+#include <type_traits>
+
+// Multi-threaded rendering (App::set_render_threads) is opt-in: define
+// TERMUI_THREADS before the include and link the platform thread library
+// (-pthread with GCC/Clang).  Without it rendering always stays on the UI
+// thread and no threads are ever started.
+#ifdef TERMUI_THREADS
+#  include <thread>
+#  include <condition_variable>
+#endif
 
 #ifdef _WIN32
 #  ifndef NOMINMAX
@@ -31,6 +47,25 @@
 #  include <dirent.h>
 #  include <sys/stat.h>
 #  include <poll.h>
+#  include <fcntl.h>
+#  include <sys/uio.h>
+#endif
+
+// SIMD kernels for ASCII scanning (see detail::ascii_prefix).  SSE2 is
+// used wherever the compiler targets it (all x86-64 builds); with GCC and
+// Clang on x86 an AVX2 kernel is also compiled and chosen at run time on
+// CPUs that support it.  Define TERMUI_NO_SIMD to use the portable code only.
+#if !defined(TERMUI_NO_SIMD) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#  define TERMUI_HAVE_SSE2 1
+#  include <emmintrin.h>
+#  if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#    define TERMUI_HAVE_AVX2_DISPATCH 1
+#    include <immintrin.h>
+#  endif
+#  ifdef _MSC_VER
+#    include <intrin.h>
+#  endif
 #endif
 
 namespace termui {
@@ -64,9 +99,94 @@ struct Style {
     Style fg(Color c) const { Style s = *this; s.fg_ = c; return s; }
     Style bg(Color c) const { Style s = *this; s.bg_ = c; return s; }
 
-    std::string begin() const {
+    // Escape sequence selecting this style from a reset state.  Sequences are
+    // encoded once per process and interned; the reference stays valid for
+    // the lifetime of the program.
+    const std::string& begin() const { return sgr(pack()); }
+
+    static std::string reset() { return "\033[0m"; }
+
+    // Interned begin() sequence for a packed style (see pack()).
+    static const std::string& sgr(uint32_t packed) {
+        // 8 attribute combinations × 17 fg × 17 bg.  Built eagerly on first
+        // use; function-local static initialisation is thread-safe in C++11.
+        static const std::vector<std::string> table = build_sgr_table();
+        const uint32_t fg = std::min((packed >> 3) & 0x1Fu, 16u);
+        const uint32_t bg = std::min((packed >> 8) & 0x1Fu, 16u);
+        return table[(packed & 7u) + 8u * (fg + 17u * bg)];
+    }
+
+    // Appends the shortest SGR sequence that takes the terminal from packed
+    // style `from` to packed style `to`: either the full interned sequence
+    // (which starts with a reset) or only the attributes that differ.
+    // Appends nothing when the styles match.
+    static void append_transition(std::string& out, uint32_t from, uint32_t to) {
+        if (from == to) return;
+        char delta[32];
+        size_t n = 0;
+        auto param = [&](int code) {
+            if (n == 0) { delta[n++] = '\033'; delta[n++] = '['; }
+            else        { delta[n++] = ';'; }
+            if (code >= 100) delta[n++] = static_cast<char>('0' + code / 100);
+            if (code >= 10)  delta[n++] = static_cast<char>('0' + (code / 10) % 10);
+            delta[n++] = static_cast<char>('0' + code % 10);
+        };
+        static const int on_codes[3]  = { 1, 4, 7 };
+        static const int off_codes[3] = { 22, 24, 27 };
+        for (int bit = 0; bit < 3; ++bit) {
+            const bool was = (from >> bit) & 1u;
+            const bool now = (to >> bit) & 1u;
+            if (was != now) param(now ? on_codes[bit] : off_codes[bit]);
+        }
+        const uint32_t from_fg = (from >> 3) & 0x1Fu, to_fg = (to >> 3) & 0x1Fu;
+        const uint32_t from_bg = (from >> 8) & 0x1Fu, to_bg = (to >> 8) & 0x1Fu;
+        if (from_fg != to_fg)
+            param(to_fg == 0 ? 39 : static_cast<int>(index_color(to_fg)));
+        if (from_bg != to_bg)
+            param(to_bg == 0 ? 49 : static_cast<int>(index_color(to_bg)) + 10);
+        delta[n++] = 'm';
+
+        const std::string& full = sgr(to);
+        if (n < full.size()) out.append(delta, n);
+        else                 out += full;
+    }
+
+    // Packs the style into 13 bits for cell storage and comparison.
+    // Layout: bit 0 bold, bit 1 underline, bit 2 reverse, bits 3-7 foreground
+    // index, bits 8-12 background index.  The default style packs to 0.
+    uint32_t pack() const {
+        return (is_bold_ ? 1u : 0u) | (is_underline_ ? 2u : 0u) | (is_reverse_ ? 4u : 0u)
+             | (color_index(fg_) << 3) | (color_index(bg_) << 8);
+    }
+
+    static Style unpack(uint32_t bits) {
+        Style s;
+        s.is_bold_      = (bits & 1u) != 0;
+        s.is_underline_ = (bits & 2u) != 0;
+        s.is_reverse_   = (bits & 4u) != 0;
+        s.fg_ = index_color((bits >> 3) & 0x1Fu);
+        s.bg_ = index_color((bits >> 8) & 0x1Fu);
+        return s;
+    }
+
+private:
+    // Dense color index: Default → 0, standard 30-37 → 1-8, bright 90-97 → 9-16.
+    static uint32_t color_index(Color c) {
+        const int code = static_cast<int>(c);
+        if (code >= 30 && code <= 37) return static_cast<uint32_t>(code - 29);
+        if (code >= 90 && code <= 97) return static_cast<uint32_t>(code - 81);
+        return 0;
+    }
+
+    static Color index_color(uint32_t idx) {
+        if (idx >= 1 && idx <= 8)  return static_cast<Color>(static_cast<int>(idx) + 29);
+        if (idx >= 9 && idx <= 16) return static_cast<Color>(static_cast<int>(idx) + 81);
+        return Color::Default;
+    }
+
+    std::string encode() const {
         std::string seq;
-        seq.reserve(16);
+        seq.reserve(24);
         seq = "\033[0";
         if (is_bold_)      seq += ";1";
         if (is_underline_) seq += ";4";
@@ -79,9 +199,15 @@ struct Style {
         return seq;
     }
 
-    static std::string reset() { return "\033[0m"; }
+    static std::vector<std::string> build_sgr_table() {
+        std::vector<std::string> table(8 * 17 * 17);
+        for (uint32_t bg = 0; bg < 17; ++bg)
+            for (uint32_t fg = 0; fg < 17; ++fg)
+                for (uint32_t attrs = 0; attrs < 8; ++attrs)
+                    table[attrs + 8 * (fg + 17 * bg)] = unpack(attrs | (fg << 3) | (bg << 8)).encode();
+        return table;
+    }
 
-private:
     Color fg_;
     Color bg_;
     bool  is_bold_;
@@ -94,61 +220,380 @@ namespace detail {
 // Returns the byte length of the UTF-8 sequence starting at s[i].
 // Returns 0 for continuation bytes, invalid lead bytes, or if i >= s.size().
 // Callers should skip invalid positions (i.e. call ++i; continue on return 0).
-inline size_t utf8_char_len(const std::string& s, size_t i) {
-    const size_t len = s.size();
-    if (i >= len) return 0;
-    unsigned char c = static_cast<unsigned char>(s[i]);
+inline size_t utf8_char_len(const char* p, size_t len) {
+    if (len == 0) return 0;
+    unsigned char c = static_cast<unsigned char>(p[0]);
     size_t n = (c < 0x80)           ? 1
              : ((c & 0xE0) == 0xC0) ? 2
              : ((c & 0xF0) == 0xE0) ? 3
              : ((c & 0xF8) == 0xF0) ? 4
              : 0; // continuation or invalid lead byte
-    if (n == 0 || i + n > len) return 0;
+    if (n == 0 || n > len) return 0;
     return n;
 }
+
+inline size_t utf8_char_len(const std::string& s, size_t i) {
+    return i < s.size() ? utf8_char_len(s.data() + i, s.size() - i) : 0;
+}
+
+// Decodes the n-byte sequence at p, where n came from utf8_char_len.  Like
+// utf8_char_len, continuation bytes are not validated.
+inline uint32_t utf8_decode(const char* p, size_t n) {
+    const unsigned char* u = reinterpret_cast<const unsigned char*>(p);
+    switch (n) {
+    case 1:  return u[0];
+    case 2:  return (u[0] & 0x1Fu) << 6 | (u[1] & 0x3Fu);
+    case 3:  return (u[0] & 0x0Fu) << 12 | (u[1] & 0x3Fu) << 6 | (u[2] & 0x3Fu);
+    default: return (u[0] & 0x07u) << 18 | (u[1] & 0x3Fu) << 12 | (u[2] & 0x3Fu) << 6 | (u[3] & 0x3Fu);
+    }
+}
+
+// Index of the lowest set bit of a non-zero mask.
+inline unsigned lowest_bit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward(&i, mask);
+    return static_cast<unsigned>(i);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+// Number of leading bytes of [p, p + n) that are ASCII (< 0x80), eight at
+// a time.
+inline size_t ascii_prefix_scalar(const char* p, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, p + i, 8);
+        if (w & 0x8080808080808080ull) break;
+    }
+    while (i < n && static_cast<unsigned char>(p[i]) < 0x80) ++i;
+    return i;
+}
+
+#ifdef TERMUI_HAVE_SSE2
+inline size_t ascii_prefix_sse2(const char* p, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const uint32_t high = static_cast<uint32_t>(_mm_movemask_epi8(v)); // top bit of each byte
+        if (high) return i + lowest_bit(high);
+    }
+    return i + ascii_prefix_scalar(p + i, n - i);
+}
+#endif
+
+#ifdef TERMUI_HAVE_AVX2_DISPATCH
+__attribute__((target("avx2")))
+inline size_t ascii_prefix_avx2(const char* p, size_t n) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const uint32_t high = static_cast<uint32_t>(_mm256_movemask_epi8(v));
+        if (high) return i + lowest_bit(high);
+    }
+    return i + ascii_prefix_sse2(p + i, n - i);
+}
+
+inline bool cpu_has_avx2() {
+    static const bool has = __builtin_cpu_supports("avx2") != 0;
+    return has;
+}
+#endif
+
+// Number of leading ASCII bytes of [p, p + n), using the widest kernel the
+// CPU supports.  The UTF-8 helpers use it to skip over ASCII runs, which
+// are one column per byte, instead of decoding them byte by byte.
+inline size_t ascii_prefix(const char* p, size_t n) {
+#if defined(TERMUI_HAVE_AVX2_DISPATCH)
+    if (n >= 32 && cpu_has_avx2()) return ascii_prefix_avx2(p, n);
+#endif
+#if defined(TERMUI_HAVE_SSE2)
+    return ascii_prefix_sse2(p, n);
+#else
+    return ascii_prefix_scalar(p, n);
+#endif
+}
+
+// Column class of a codepoint.  WIDTH_SPECIAL marks the few codepoints
+// whose width depends on their neighbours (see next_cluster).
+enum WidthClass {
+    WIDTH_ZERO    = 0, // combining and enclosing marks, format characters
+    WIDTH_NARROW  = 1,
+    WIDTH_WIDE    = 2, // East Asian Wide and Fullwidth, emoji presentation
+    WIDTH_SPECIAL = 3  // ZWJ, VS16, regional indicators, emoji modifiers
+};
+
+// Two-level tables at the end of this file, 2 bits per codepoint.
+inline const uint8_t* width_stage1();
+inline const uint8_t* width_stage2();
+
+// Looks up the WidthClass of cp: one byte of stage 1 selects a 32-byte
+// block of stage 2 covering 128 codepoints.  Blocks are 32-byte aligned,
+// so the second read never straddles a cache line.  Planes 4-13 and 15-16
+// hold nothing wider or narrower than one column and are not stored.
+inline unsigned width_class(uint32_t cp) {
+    if (cp >= 0x40000) {
+        if (cp < 0xE0000 || cp >= 0xE1000) return WIDTH_NARROW;
+        cp -= 0xE0000 - 0x40000; // plane 14 (tags, variation selectors) is stored after plane 3
+    }
+    const uint8_t bits = width_stage2()[width_stage1()[cp >> 7] * 32u + ((cp & 0x7Fu) >> 2)];
+    return (bits >> ((cp & 3u) * 2)) & 3u;
+}
+
+// Measures the grapheme cluster at the start of [p, p + n): a base
+// character plus any combining marks, variation selectors and emoji
+// modifiers after it, characters joined on by ZWJ, or a pair of regional
+// indicators (a flag).  Stores its width in columns — the base's, widened
+// to 2 by VS16 (emoji presentation) and for flags — and returns its length
+// in bytes, at least 1 when n > 0.  Width 0 means nothing to display
+// (invalid bytes, or marks with no base) and callers drop such clusters.
+// Control characters have width 1; CellBuffer::put draws them as spaces.
+inline size_t next_cluster(const char* p, size_t n, int& width) {
+    size_t i = utf8_char_len(p, n);
+    if (i == 0) { width = 0; return n > 0 ? 1 : 0; } // continuation or invalid: skip
+    const uint32_t cp = utf8_decode(p, i);
+    unsigned cls = cp < 0x80 ? static_cast<unsigned>(WIDTH_NARROW) : width_class(cp);
+    bool flag_open = false; // base is a lone regional indicator
+    if (cls == WIDTH_SPECIAL) {
+        if (cp >= 0x1F1E6 && cp <= 0x1F1FF) { cls = WIDTH_NARROW; flag_open = true; }
+        else if (cp >= 0x1F3FB)             cls = WIDTH_WIDE; // modifier on its own
+        else                                cls = WIDTH_ZERO; // ZWJ or VS16 with no base
+    }
+    width = static_cast<int>(cls);
+    bool joined = false; // the previous codepoint was a ZWJ
+    while (i < n && static_cast<unsigned char>(p[i]) >= 0x80) { // ASCII never extends
+        const size_t len = utf8_char_len(p + i, n - i);
+        if (len == 0) break;
+        const uint32_t next = utf8_decode(p + i, len);
+        const unsigned c = width_class(next);
+        if (joined) {
+            joined = false;
+        } else if (c == WIDTH_SPECIAL) {
+            if (next == 0x200D) {
+                joined = true;
+            } else if (next == 0xFE0F) {
+                if (width == 1) width = 2;
+            } else if (next >= 0x1F1E6 && next <= 0x1F1FF) {
+                if (!flag_open) break;
+                flag_open = false;
+                width = 2;
+            } else if (width != 2) {
+                break; // a modifier only extends an emoji
+            }
+        } else if (c != WIDTH_ZERO) {
+            break;
+        }
+        i += len;
+    }
+    return i;
+}
+
+// Returns a fresh value from a process-wide, strictly increasing counter.
+// Widgets stamp themselves with it on every visible mutation, so comparing
+// stamps tells App whether anything changed since the last frame.  Atomic:
+// Text and other widgets may be built on any thread.
+inline uint64_t next_generation() {
+    static std::atomic<uint64_t> counter(0);
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+// Newest title stamp of any Page, raised by Page whenever a title or tab
+// style changes, so App can tell that the tab bar needs relaying out without
+// visiting every page.
+inline std::atomic<uint64_t>& newest_title_ref() {
+    static std::atomic<uint64_t> g(0);
+    return g;
+}
+
+inline void note_title_generation(uint64_t g) {
+    std::atomic<uint64_t>& newest = newest_title_ref();
+    uint64_t cur = newest.load(std::memory_order_relaxed);
+    while (cur < g && !newest.compare_exchange_weak(cur, g, std::memory_order_relaxed)) {}
+}
 } // namespace detail
 
 // ─── UTF-8 Helpers ──────────────────────────────────────────────────────────
 
-// Returns the display width (column count) of a UTF-8 string.
-// Assumes all codepoints are single-width (no CJK fullwidth).
+// Returns the display width (column count) of a UTF-8 string.  East Asian
+// wide characters and emoji take two columns; combining marks, ZWJ emoji
+// sequences and flags are measured as whole grapheme clusters.
 inline size_t utf8_display_width(const std::string& s) {
     size_t width = 0;
     size_t i = 0;
     const size_t len = s.size();
+    const char* p = s.data();
     while (i < len) {
-        size_t char_len = detail::utf8_char_len(s, i);
-        if (char_len == 0) { ++i; continue; } // continuation or invalid: skip
-        i += char_len;
-        ++width;
+        // ASCII runs: one column per byte.  The byte before a non-ASCII one
+        // is left to next_cluster, which may attach marks to it.
+        size_t run = detail::ascii_prefix(p + i, len - i);
+        if (run > 0 && i + run < len) --run;
+        width += run;
+        i += run;
+        if (i >= len) break;
+        int w;
+        i += detail::next_cluster(p + i, len - i, w);
+        width += static_cast<size_t>(w);
     }
     return width;
 }
 
-// Truncate a UTF-8 string to at most max_width display columns.
-inline std::string utf8_truncate(const std::string& s, size_t max_width) {
-    size_t width = 0;
+namespace detail {
+// Measures and truncates in one pass: returns the byte length of the
+// longest prefix of [p, p + len) that fits in max_width columns without
+// splitting a grapheme cluster, and stores that prefix's width.  The whole
+// input fits exactly when the result is len.
+inline size_t utf8_fit(const char* p, size_t len, size_t max_width, size_t& width) {
+    width = 0;
     size_t i = 0;
-    const size_t len = s.size();
-    while (i < len && width < max_width) {
-        size_t char_len = detail::utf8_char_len(s, i);
-        if (char_len == 0) { ++i; continue; } // continuation or invalid: skip
-        i += char_len;
-        ++width;
+    while (i < len) {
+        // ASCII runs: one column per byte (see utf8_display_width).
+        size_t run = ascii_prefix(p + i, std::min(len - i, max_width - width));
+        if (run > 0 && i + run < len) --run;
+        width += run;
+        i += run;
+        if (i >= len) break;
+        int w;
+        const size_t n = next_cluster(p + i, len - i, w);
+        if (width + static_cast<size_t>(w) > max_width) break;
+        width += static_cast<size_t>(w);
+        i += n;
     }
-    return s.substr(0, i);
+    return i;
+}
+} // namespace detail
+
+// Truncate a UTF-8 string to at most max_width display columns, never
+// splitting a grapheme cluster.
+inline std::string utf8_truncate(const std::string& s, size_t max_width) {
+    size_t width;
+    return s.substr(0, detail::utf8_fit(s.data(), s.size(), max_width, width));
 }
 
+// ─── Small Vector ───────────────────────────────────────────────────────────
+
+namespace detail {
+
+// A vector that keeps its first N elements inside the object and moves to
+// the heap only when it grows past them.  Provides just what Text needs.
+template <typename T, size_t N>
+class SmallVector {
+public:
+    SmallVector() : data_(inline_data()), size_(0), cap_(N) {}
+    SmallVector(const SmallVector& o) : SmallVector() { copy_from(o); }
+    SmallVector(SmallVector&& o) noexcept : SmallVector() { take(o); }
+    SmallVector& operator=(const SmallVector& o) {
+        if (this != &o) {
+            clear();
+            copy_from(o);
+        }
+        return *this;
+    }
+    SmallVector& operator=(SmallVector&& o) noexcept {
+        if (this != &o) {
+            clear();
+            release();
+            take(o);
+        }
+        return *this;
+    }
+    ~SmallVector() {
+        clear();
+        release();
+    }
+
+    void push_back(T&& v) {
+        if (size_ == cap_) reallocate(cap_ * 2);
+        new (data_ + size_) T(std::move(v));
+        ++size_;
+    }
+
+    void reserve(size_t n) { if (n > cap_) reallocate(n); }
+    void clear() {
+        for (size_t i = 0; i < size_; ++i) data_[i].~T();
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    T&       operator[](size_t i)       { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+    T&       back()       { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    T*       begin()       { return data_; }
+    T*       end()         { return data_ + size_; }
+    const T* begin() const { return data_; }
+    const T* end()   const { return data_ + size_; }
+
+private:
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type inline_[N];
+    T*     data_;
+    size_t size_;
+    size_t cap_;
+
+    T* inline_data() { return reinterpret_cast<T*>(inline_); }
+    bool is_inline() const { return data_ == reinterpret_cast<const T*>(inline_); }
+
+    void reallocate(size_t cap) {
+        T* fresh = static_cast<T*>(::operator new(cap * sizeof(T)));
+        for (size_t i = 0; i < size_; ++i) {
+            new (fresh + i) T(std::move(data_[i]));
+            data_[i].~T();
+        }
+        release();
+        data_ = fresh;
+        cap_  = cap;
+    }
+
+    // Frees heap storage and returns to the inline buffer.  Must be empty.
+    void release() {
+        if (!is_inline()) ::operator delete(data_);
+        data_ = inline_data();
+        cap_  = N;
+    }
+
+    void copy_from(const SmallVector& o) {
+        reserve(o.size_);
+        for (size_t i = 0; i < o.size_; ++i) new (data_ + i) T(o.data_[i]);
+        size_ = o.size_;
+    }
+
+    // Takes o's elements, leaving o empty.  *this must be empty and inline.
+    void take(SmallVector& o) {
+        if (o.is_inline()) {
+            for (size_t i = 0; i < o.size_; ++i) new (data_ + i) T(std::move(o.data_[i]));
+            size_ = o.size_;
+            o.clear();
+        } else {
+            data_   = o.data_;
+            size_   = o.size_;
+            cap_    = o.cap_;
+            o.data_ = o.inline_data();
+            o.size_ = 0;
+            o.cap_  = N;
+        }
+    }
+};
+
+} // namespace detail
+
 // ─── Text ───────────────────────────────────────────────────────────────────
 
 struct TextSpan {
     std::string content;
     Style style;
+    size_t width = 0; // display width of content, measured on construction
 
     TextSpan() = default;
-    explicit TextSpan(const std::string& text) : content(text), style() {}
-    TextSpan(const std::string& text, const Style& s) : content(text), style(s) {}
-    TextSpan(std::string&& text, const Style& s) : content(std::move(text)), style(s) {}
+    explicit TextSpan(const std::string& text)
+        : content(text), style(), width(utf8_display_width(content)) {}
+    TextSpan(const std::string& text, const Style& s)
+        : content(text), style(s), width(utf8_display_width(content)) {}
+    TextSpan(std::string&& text, const Style& s)
+        : content(std::move(text)), style(s), width(utf8_display_width(content)) {}
 };
 
 class Text {
@@ -156,14 +601,32 @@ public:
     Text() = default;
     Text(const Text&) = default;
     Text& operator=(const Text&) = default;
-    Text(Text&&) noexcept = default;
-    Text& operator=(Text&&) noexcept = default;
-    explicit Text(const std::string& content) { spans_.push_back(TextSpan(content)); }
-    Text(const std::string& content, const Style& s) { spans_.push_back(TextSpan(content, s)); }
-    Text(const std::string& content, Color fg) { spans_.push_back(TextSpan(content, Style(fg))); }
+    // Moves leave the source empty with a fresh revision, so it can never be
+    // mistaken for the content it gave away.
+    Text(Text&& other) noexcept
+        : spans_(std::move(other.spans_)), width_(other.width_), revision_(other.revision_) {
+        other.spans_.clear();
+        other.width_ = 0;
+        other.changed();
+    }
+    Text& operator=(Text&& other) noexcept {
+        if (this != &other) {
+            spans_    = std::move(other.spans_);
+            width_    = other.width_;
+            revision_ = other.revision_;
+            other.spans_.clear();
+            other.width_ = 0;
+            other.changed();
+        }
+        return *this;
+    }
+    explicit Text(const std::string& content) { push(TextSpan(content)); }
+    Text(const std::string& content, const Style& s) { push(TextSpan(content, s)); }
+    Text(const std::string& content, Color fg) { push(TextSpan(content, Style(fg))); }
 
     Text& add(const std::string& content, const Style& s = Style()) {
-        spans_.push_back(TextSpan(content, s));
+        push(TextSpan(content, s));
+        changed();
         return *this;
     }
 
@@ -172,7 +635,8 @@ public:
     }
 
     Text& add(std::string&& content, const Style& s = Style()) {
-        spans_.push_back(TextSpan(std::move(content), s));
+        push(TextSpan(std::move(content), s));
+        changed();
         return *this;
     }
 
@@ -182,41 +646,65 @@ public:
 
     // Renders the text to an ANSI escape sequence string.
     // If max_width > 0, content is truncated to at most max_width display columns.
+    // The output assumes default attributes on entry, emits only the attribute
+    // changes between spans, and leaves the terminal in the default style.
     std::string render(int max_width = 0) const {
         std::string out;
         out.reserve(spans_.size() * 32);
+        uint32_t current = 0;
         int remaining = max_width;
         for (const TextSpan& span : spans_) {
             if (max_width > 0 && remaining <= 0) break;
-            const std::string* text = &span.content;
-            std::string truncated;
+            // Spans that fit whole are appended without a scan; only the
+            // span that crosses max_width is measured, in the same pass
+            // that truncates it.
+            size_t bytes = span.content.size();
             if (max_width > 0) {
-                const int w = static_cast<int>(utf8_display_width(span.content));
-                if (w > remaining) {
-                    truncated = utf8_truncate(span.content, static_cast<size_t>(remaining));
-                    text = &truncated;
-                    remaining = 0;
+                if (span.width <= static_cast<size_t>(remaining)) {
+                    remaining -= static_cast<int>(span.width);
                 } else {
-                    remaining -= w;
+                    size_t w;
+                    bytes = detail::utf8_fit(span.content.data(), bytes, static_cast<size_t>(remaining), w);
+                    remaining = 0;
                 }
             }
-            out += span.style.begin();
-            out += *text;
-            out += "\033[0m";
+            const uint32_t style = span.style.pack();
+            Style::append_transition(out, current, style);
+            current = style;
+            out.append(span.content.data(), bytes);
         }
+        Style::append_transition(out, current, 0);
         return out;
     }
 
-    // Returns the total display-column width (not byte length).
-    size_t length() const {
-        size_t len = 0;
-        for (const TextSpan& span : spans_)
-            len += utf8_display_width(span.content);
-        return len;
-    }
+    // Returns the total display-column width (not byte length): the sum of
+    // the span widths, kept up to date by add().
+    size_t length() const { return width_; }
+
+    // Spans are stored inline up to INLINE_SPANS, so typical lines need no
+    // allocation beyond what their strings need (short strings are stored
+    // inline by std::string itself).
+    enum { INLINE_SPANS = 2 };
+    typedef detail::SmallVector<TextSpan, INLINE_SPANS> Spans;
+
+    const Spans& spans() const { return spans_; }
+
+    // Stamp identifying this content: taken fresh on construction and on
+    // every add(), and carried over by copies.  Equal revisions mean equal
+    // spans, which lets App skip repainting rows whose line is unchanged.
+    uint64_t revision() const { return revision_; }
 
 private:
-    std::vector<TextSpan> spans_;
+    Spans spans_;
+    size_t width_ = 0; // sum of spans_[i].width
+    uint64_t revision_ = detail::next_generation();
+
+    void push(TextSpan&& span) {
+        width_ += span.width;
+        spans_.push_back(std::move(span));
+    }
+
+    void changed() { revision_ = detail::next_generation(); }
 };
 
 // ─── Table ──────────────────────────────────────────────────────────────────
@@ -226,7 +714,8 @@ public:
     struct Column {
         std::string name;
         int width; // 0 = auto-sized to content
-        Column(const std::string& n, int w) : name(n), width(w) {}
+        size_t name_width; // display width of name
+        Column(const std::string& n, int w) : name(n), width(w), name_width(utf8_display_width(n)) {}
     };
 
     Table() {
@@ -244,6 +733,10 @@ public:
 
     Table& add_row(const std::vector<std::string>& cells) {
         rows_.push_back(cells);
+        std::vector<size_t> widths;
+        widths.reserve(cells.size());
+        for (const std::string& cell : cells) widths.push_back(utf8_display_width(cell));
+        cell_widths_.push_back(std::move(widths));
         return *this;
     }
 
@@ -259,10 +752,10 @@ public:
             if (columns_[c].width > 0) {
                 widths[c] = static_cast<size_t>(columns_[c].width);
             } else {
-                widths[c] = utf8_display_width(columns_[c].name);
+                widths[c] = columns_[c].name_width;
                 for (size_t r = 0; r < rows_.size(); ++r) {
                     if (c < rows_[r].size()) {
-                        size_t cell_w = utf8_display_width(rows_[r][c]);
+                        size_t cell_w = cell_widths_[r][c];
                         if (cell_w > widths[c]) widths[c] = cell_w;
                     }
                 }
@@ -287,7 +780,8 @@ public:
         Text header;
         for (size_t c = 0; c < columns_.size(); ++c) {
             if (c > 0) header.add(" \xe2\x94\x82 ", Style(Color::BrightBlack));
-            header.add(pad_or_truncate(columns_[c].name, static_cast<int>(widths[c])), header_style_);
+            header.add(pad_or_truncate(columns_[c].name, columns_[c].name_width, static_cast<int>(widths[c])),
+                       header_style_);
         }
         result.push_back(header);
 
@@ -308,8 +802,9 @@ public:
             Text row;
             for (size_t c = 0; c < columns_.size(); ++c) {
                 if (c > 0) row.add(" \xe2\x94\x82 ", Style(Color::BrightBlack));
-                const std::string& cell = (c < rows_[r].size()) ? rows_[r][c] : empty_str();
-                row.add(pad_or_truncate(cell, static_cast<int>(widths[c])));
+                const bool present = c < rows_[r].size();
+                const std::string& cell = present ? rows_[r][c] : empty_str();
+                row.add(pad_or_truncate(cell, present ? cell_widths_[r][c] : 0, static_cast<int>(widths[c])));
             }
             result.push_back(row);
         }
@@ -320,6 +815,7 @@ public:
 private:
     std::vector<Column> columns_;
     std::vector<std::vector<std::string>> rows_;
+    std::vector<std::vector<size_t>> cell_widths_; // display widths of rows_, measured by add_row()
     Style header_style_;
 
     // Returns a ref to an empty string; avoids constructing temporaries in render().
@@ -328,13 +824,21 @@ private:
         return s;
     }
 
-    static std::string pad_or_truncate(const std::string& s, int width) {
+    // Pads or truncates s, whose display width is s_width, to width columns.
+    static std::string pad_or_truncate(const std::string& s, size_t s_width, int width) {
         if (width <= 0) return "";
-        int len = static_cast<int>(utf8_display_width(s));
-        if (len <= width)
-            return s + std::string(static_cast<size_t>(width - len), ' ');
+        if (s_width <= static_cast<size_t>(width)) {
+            std::string out;
+            out.reserve(s.size() + static_cast<size_t>(width) - s_width);
+            out += s;
+            out.append(static_cast<size_t>(width) - s_width, ' ');
+            return out;
+        }
         if (width <= 1) return "\xe2\x80\xa6"; // …
-        return utf8_truncate(s, static_cast<size_t>(width - 1)) + "\xe2\x80\xa6";
+        size_t len;
+        std::string out(s, 0, detail::utf8_fit(s.data(), s.size(), static_cast<size_t>(width - 1), len));
+        out += "\xe2\x80\xa6";
+        return out;
     }
 };
 
@@ -417,9 +921,24 @@ enum Key {
     KEY_ENTER,
     KEY_SPACE,
     KEY_RESIZE,
+    KEY_GOTO,      // 'g': open the go-to-tab prompt
+    KEY_BACKSPACE,
+    KEY_ESCAPE,    // a lone ESC
+    KEY_CHAR,      // any other printable byte; see last_char()
+    KEY_CPR,       // cursor position report, the reply to DSR 6
+    KEY_FOCUS_IN,  // terminal window gained focus (mode 1004)
+    KEY_FOCUS_OUT, // terminal window lost focus
     KEY_OTHER
 };
 
+// The byte behind the most recent single-byte key (KEY_CHAR, KEY_QUIT,
+// KEY_SPACE, KEY_GOTO), for text entry.
+inline char& last_char_ref() {
+    static char c = 0;
+    return c;
+}
+inline char last_char() { return last_char_ref(); }
+
 struct TermSize {
     int cols;
     int rows;
@@ -432,6 +951,11 @@ inline HANDLE& hStdin_ref()  { static HANDLE h = INVALID_HANDLE_VALUE; return h;
 inline DWORD&  orig_out_mode_ref() { static DWORD v = 0; return v; }
 inline DWORD&  orig_in_mode_ref()  { static DWORD v = 0; return v; }
 inline UINT&   orig_cp_ref()       { static UINT  v = 0; return v; }
+inline bool&   no_auto_return_ref() { static bool v = false; return v; }
+
+#ifndef DISABLE_NEWLINE_AUTO_RETURN
+#define DISABLE_NEWLINE_AUTO_RETURN 0x0008
+#endif
 
 inline void enter_raw_mode() {
     hStdout_ref() = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -439,7 +963,11 @@ inline void enter_raw_mode() {
     GetConsoleMode(hStdout_ref(), &orig_out_mode_ref());
     GetConsoleMode(hStdin_ref(),  &orig_in_mode_ref());
     DWORD out_mode = orig_out_mode_ref() | ENABLE_VIRTUAL_TERMINAL_PROCESSING;
-    SetConsoleMode(hStdout_ref(), out_mode);
+    // DISABLE_NEWLINE_AUTO_RETURN makes LF move straight down and defers the
+    // wrap after the last column, as on a POSIX terminal with OPOST off.
+    // Consoles that predate it reject the whole mode.
+    no_auto_return_ref() = SetConsoleMode(hStdout_ref(), out_mode | DISABLE_NEWLINE_AUTO_RETURN) != 0;
+    if (!no_auto_return_ref()) SetConsoleMode(hStdout_ref(), out_mode);
     DWORD in_mode = ENABLE_WINDOW_INPUT;
     SetConsoleMode(hStdin_ref(), in_mode);
     orig_cp_ref() = GetConsoleOutputCP();
@@ -462,10 +990,19 @@ inline TermSize get_terminal_size() {
     return ts;
 }
 
-inline Key read_key() {
+// True when input is waiting to be read, without consuming it.
+inline bool input_pending() {
+    DWORD n = 0;
+    return GetNumberOfConsoleInputEvents(hStdin_ref(), &n) && n > 0;
+}
+
+// Waits up to timeout_ms for input and returns the next key, or KEY_NONE.
+// watch_output is accepted for parity with POSIX; console writes never block.
+inline Key read_key(int timeout_ms = 100, bool watch_output = false) {
+    (void)watch_output;
     INPUT_RECORD ir;
     DWORD count;
-    DWORD wait_result = WaitForSingleObject(hStdin_ref(), 100);
+    DWORD wait_result = WaitForSingleObject(hStdin_ref(), static_cast<DWORD>(std::max(0, timeout_ms)));
     if (wait_result != WAIT_OBJECT_0) return KEY_NONE;
     while (true) {
         if (!PeekConsoleInput(hStdin_ref(), &ir, 1, &count) || count == 0)
@@ -476,7 +1013,11 @@ inline Key read_key() {
         WORD vk = ir.Event.KeyEvent.wVirtualKeyCode;
         WCHAR wch = ir.Event.KeyEvent.uChar.UnicodeChar;
         if (vk == VK_RETURN)             return KEY_ENTER;
+        if (vk == VK_BACK)               return KEY_BACKSPACE;
+        if (vk == VK_ESCAPE)             return KEY_ESCAPE;
+        if (wch > 0 && wch < 0x80) last_char_ref() = static_cast<char>(wch);
         if (wch == L'q' || wch == L'Q') return KEY_QUIT;
+        if (wch == L'g')                return KEY_GOTO;
         if (wch == 3)                   return KEY_CTRL_C;
         switch (vk) {
             case VK_LEFT:  return KEY_LEFT;
@@ -485,6 +1026,7 @@ inline Key read_key() {
             case VK_DOWN:  return KEY_DOWN;
             case VK_SPACE: return KEY_SPACE;
         }
+        if (wch >= 0x20 && wch < 0x7F) return KEY_CHAR;
         if (wch != 0) return KEY_OTHER;
     }
 }
@@ -506,6 +1048,14 @@ inline volatile sig_atomic_t& g_resize_flag_ref() {
     static volatile sig_atomic_t flag = 0;
     return flag;
 }
+// stdout's file status flags from before FrameOutput set O_NONBLOCK, or -1
+// while it is not set.  Kept here so the SIGINT/SIGTERM handler can restore
+// them: the flag lives on the open file description, which a tty shares
+// with stdin and with the parent shell.
+inline volatile sig_atomic_t& saved_stdout_flags_ref() {
+    static volatile sig_atomic_t flags = -1;
+    return flags;
+}
 
 inline void exit_raw_mode() {
     if (raw_mode_active_ref()) {
@@ -538,20 +1088,53 @@ inline TermSize get_terminal_size() {
     return ts;
 }
 
-inline Key read_key() {
+// True when input (or a pending resize) is waiting, without consuming it.
+inline bool input_pending() {
+    if (g_resize_flag_ref()) return true;
+    struct pollfd fd;
+    fd.fd      = STDIN_FILENO;
+    fd.events  = POLLIN;
+    fd.revents = 0;
+    return ::poll(&fd, 1, 0) > 0 && (fd.revents & POLLIN);
+}
+
+// Waits up to timeout_ms for input and returns the next key, or KEY_NONE.
+// A SIGWINCH during the wait interrupts poll() and is reported immediately.
+// With watch_output, the wait also ends (returning KEY_NONE) as soon as
+// stdout can accept more bytes, so a backlogged frame can be drained.
+inline Key read_key(int timeout_ms = 100, bool watch_output = false) {
     if (g_resize_flag_ref()) {
         g_resize_flag_ref() = 0;
         return KEY_RESIZE;
     }
 
+    struct pollfd fds[2];
+    fds[0].fd      = STDIN_FILENO;
+    fds[0].events  = POLLIN;
+    fds[0].revents = 0;
+    fds[1].fd      = STDOUT_FILENO;
+    fds[1].events  = POLLOUT;
+    fds[1].revents = 0;
+    if (::poll(fds, watch_output ? 2 : 1, std::max(0, timeout_ms)) <= 0 ||
+        !(fds[0].revents & POLLIN)) {
+        if (g_resize_flag_ref()) {
+            g_resize_flag_ref() = 0;
+            return KEY_RESIZE;
+        }
+        return KEY_NONE;
+    }
+
     unsigned char c;
     ssize_t n = read(STDIN_FILENO, &c, 1);
     if (n <= 0) return KEY_NONE;
 
+    last_char_ref() = static_cast<char>(c);
     if (c == '\r')                 return KEY_ENTER;   // CR
     if (c == 'q' || c == 'Q')     return KEY_QUIT;
     if (c == '\x03')               return KEY_CTRL_C;  // ETX / Ctrl+C
     if (c == ' ')                  return KEY_SPACE;
+    if (c == 'g')                  return KEY_GOTO;
+    if (c == 127 || c == '\b')     return KEY_BACKSPACE;
 
     if (c == 27) { // ESC sequence
         // Wait up to timeout_ms for a byte on stdin; returns true if a byte arrived.
@@ -569,7 +1152,7 @@ inline Key read_key() {
             }
         };
         unsigned char seq[2];
-        if (!PollRead::read_byte(seq[0], 50)) return KEY_OTHER;
+        if (!PollRead::read_byte(seq[0], 50)) return KEY_ESCAPE;
         if (!PollRead::read_byte(seq[1], 50)) return KEY_OTHER;
         if (seq[0] == '[') {
             // Single-letter final byte: standard cursor-movement sequences.
@@ -578,6 +1161,19 @@ inline Key read_key() {
                 case 'B': return KEY_DOWN;
                 case 'C': return KEY_RIGHT;
                 case 'D': return KEY_LEFT;
+                case 'I': return KEY_FOCUS_IN;
+                case 'O': return KEY_FOCUS_OUT;
+            }
+            // Private-parameter sequences are terminal replies, e.g. a
+            // DECRQM or DA1 answer to probe_terminal() that arrived after
+            // its timeout: drain up to the final byte so the parameters
+            // are not read as typed characters.
+            if (seq[1] == '?' || seq[1] == '>' || seq[1] == '=') {
+                int limit = 64;
+                unsigned char drain;
+                while (limit-- > 0 && PollRead::read_byte(drain, 50))
+                    if (drain >= 0x40 && drain <= 0x7E) break;
+                return KEY_OTHER;
             }
             // Longer CSI sequences (e.g. \033[1;5C): drain until a letter
             // terminates the sequence so stale bytes don't pollute the next
@@ -586,6 +1182,7 @@ inline Key read_key() {
                 int limit = 32;
                 unsigned char drain;
                 while (limit-- > 0 && PollRead::read_byte(drain, 50)) {
+                    if (drain == 'R') return KEY_CPR; // \033[row;colR
                     if ((drain >= 'A' && drain <= 'Z') ||
                         (drain >= 'a' && drain <= 'z')) break;
                 }
@@ -594,6 +1191,7 @@ inline Key read_key() {
         return KEY_OTHER;
     }
 
+    if (c >= 0x20) return KEY_CHAR; // printable ASCII or a UTF-8 byte
     return KEY_OTHER;
 }
 
@@ -614,6 +1212,13 @@ inline void write_raw(const std::string& s) {
             remaining -= static_cast<size_t>(n);
         } else if (n < 0 && errno == EINTR) {
             continue; // interrupted by signal; retry
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            // stdout is in non-blocking mode (see FrameOutput); wait for room.
+            struct pollfd out;
+            out.fd      = STDOUT_FILENO;
+            out.events  = POLLOUT;
+            out.revents = 0;
+            ::poll(&out, 1, -1);
         } else {
             // Unrecoverable error (ENOSPC, EIO, EPIPE, etc.).
             // Attempt terminal restore before abandoning the write.
@@ -624,12 +1229,233 @@ inline void write_raw(const std::string& s) {
 #endif
 }
 
+// Frame output that never blocks the event loop.  While enabled, stdout is
+// switched to O_NONBLOCK and submit() writes only what the terminal accepts
+// immediately; the unwritten tail of that frame stays pending and is pushed
+// out by flush() as the terminal drains.  At most one frame is ever pending:
+// App does not compose another one while busy(), so when the terminal falls
+// behind, intermediate states are skipped and the next frame drawn reflects
+// the latest state.  A pending frame is always finished, never cut short,
+// because the frame after it is a diff that assumes it arrived in full.
+//
+// A frame is gathered from three segments — a static head, the encoded
+// body and a static tail — and sent with writev(), so the fixed escape
+// sequences around the body are never copied into it.  The body buffer is
+// swapped in, not copied, and the drained one is handed back on the next
+// submit() so its capacity is reused from frame to frame.
+// On Windows console writes are synchronous and nothing is ever pending.
+class FrameOutput {
+public:
+    FrameOutput() : seg_(0), nseg_(0), saved_flags_(-1) {}
+
+    void enable() {
+#ifndef _WIN32
+        if (saved_flags_ >= 0) return;
+        const int flags = ::fcntl(STDOUT_FILENO, F_GETFL);
+        if (flags < 0) return;
+        saved_stdout_flags_ref() = flags; // before the change, for the signal handler
+        if (::fcntl(STDOUT_FILENO, F_SETFL, flags | O_NONBLOCK) == 0) saved_flags_ = flags;
+        else saved_stdout_flags_ref() = -1;
+#endif
+    }
+
+    // Writes out any pending bytes (blocking) and restores the original
+    // stdout flags.
+    void disable() {
+        drain();
+#ifndef _WIN32
+        if (saved_flags_ >= 0) ::fcntl(STDOUT_FILENO, F_SETFL, saved_flags_);
+        saved_stdout_flags_ref() = -1;
+#endif
+        saved_flags_ = -1;
+    }
+
+    bool busy() const { return seg_ < nseg_; }
+
+    // Takes ownership of body, framed by head and tail (string literals or
+    // other storage that outlives the write), and writes as much as
+    // possible without blocking.  body receives a cleared buffer to build
+    // the next frame in.  Must not be called while busy().
+    void submit(const char* head, std::string& body, const char* tail) {
+        assert(!busy());
+        body_.swap(body);
+        body.clear();
+        nseg_ = 0;
+        seg_  = 0;
+        add_segment(head, std::strlen(head));
+        add_segment(body_.data(), body_.size());
+        add_segment(tail, std::strlen(tail));
+        if (saved_flags_ < 0) drain();
+        else flush();
+    }
+
+    // Continues writing the pending frame; returns true once it is complete.
+    bool flush() {
+#ifdef _WIN32
+        for (; seg_ < nseg_; ++seg_) {
+            DWORD written;
+            WriteConsoleA(hStdout_ref(), seg_data_[seg_], static_cast<DWORD>(seg_size_[seg_]),
+                          &written, NULL);
+        }
+#else
+        while (busy()) {
+            struct iovec iov[3];
+            for (size_t i = seg_; i < nseg_; ++i) {
+                iov[i - seg_].iov_base = const_cast<char*>(seg_data_[i]);
+                iov[i - seg_].iov_len  = seg_size_[i];
+            }
+            const ssize_t n = ::writev(STDOUT_FILENO, iov, static_cast<int>(nseg_ - seg_));
+            if (n > 0) {
+                consume(static_cast<size_t>(n));
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                return false; // terminal is backlogged; try again later
+            } else {
+                exit_raw_mode(); // unrecoverable, as in write_raw()
+                seg_ = nseg_;
+            }
+        }
+#endif
+        body_.clear();
+        seg_ = nseg_ = 0;
+        return true;
+    }
+
+private:
+    std::string body_;
+    const char* seg_data_[3];
+    size_t      seg_size_[3];
+    size_t seg_;         // first segment not yet fully written
+    size_t nseg_;        // segments in the pending frame
+    int saved_flags_;    // original stdout flags; -1 when not enabled
+
+    void add_segment(const char* data, size_t size) {
+        if (size == 0) return;
+        seg_data_[nseg_] = data;
+        seg_size_[nseg_] = size;
+        ++nseg_;
+    }
+
+    // Advances past n written bytes, possibly into the middle of a segment.
+    void consume(size_t n) {
+        while (n > 0 && seg_ < nseg_) {
+            const size_t step = std::min(n, seg_size_[seg_]);
+            seg_data_[seg_] += step;
+            seg_size_[seg_] -= step;
+            n -= step;
+            if (seg_size_[seg_] == 0) ++seg_;
+        }
+    }
+
+    // Finishes the pending frame, waiting for the terminal as needed.
+    void drain() {
+        while (!flush()) {
+#ifndef _WIN32
+            struct pollfd out;
+            out.fd      = STDOUT_FILENO;
+            out.events  = POLLOUT;
+            out.revents = 0;
+            ::poll(&out, 1, -1);
+#endif
+        }
+    }
+};
+
 inline void clear_screen() { write_raw("\033[2J"); }
 inline void move_cursor(int row, int col) {
     write_raw("\033[" + std::to_string(row + 1) + ";" + std::to_string(col + 1) + "H");
 }
 inline void hide_cursor() { write_raw("\033[?25l"); }
 inline void show_cursor() { write_raw("\033[?25h"); }
+inline void enter_alt_screen() { write_raw("\033[?1049h"); }
+inline void exit_alt_screen()  { write_raw("\033[?1049l"); }
+// Focus reporting (DEC private mode 1004): the terminal sends CSI I on
+// focus-in and CSI O on focus-out.  Terminals without it ignore the mode.
+inline void enable_focus_events()  { write_raw("\033[?1004h"); }
+inline void disable_focus_events() { write_raw("\033[?1004l"); }
+
+// Sends query followed by a DA1 request (CSI c) and returns every byte the
+// terminal sends back, up to and including the DA1 reply.  Every VT100-class
+// terminal answers DA1, so queries it does not understand cost one round
+// trip rather than a full timeout.  Must be called in raw mode; returns an
+// empty string when stdin is not a terminal or nothing arrives within
+// timeout_ms.
+inline std::string query_terminal(const std::string& query, int timeout_ms = 200) {
+    std::string reply;
+#ifndef _WIN32
+    if (!raw_mode_active_ref()) return reply;
+    write_raw(query + "\033[c");
+    const std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (true) {
+        const long long left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        struct pollfd in;
+        in.fd      = STDIN_FILENO;
+        in.events  = POLLIN;
+        in.revents = 0;
+        if (left <= 0 || ::poll(&in, 1, static_cast<int>(left)) <= 0) break;
+        char chunk[256];
+        const ssize_t n = ::read(STDIN_FILENO, chunk, sizeof(chunk));
+        if (n <= 0) break;
+        reply.append(chunk, static_cast<size_t>(n));
+        // The DA1 reply is CSI ? <params> c and always arrives last.
+        const size_t da = reply.rfind("\033[?");
+        if (da != std::string::npos && reply.find('c', da) != std::string::npos) break;
+    }
+#else
+    (void)query;
+    (void)timeout_ms;
+#endif
+    return reply;
+}
+
+// Returns true if reply holds a DECRQM report (CSI ? mode ; Ps $ y) saying
+// the terminal recognises the private mode (Ps 1-4; 0 means unknown).
+inline bool decrqm_recognised(const std::string& reply, int mode) {
+    const std::string prefix = "\033[?" + std::to_string(mode) + ";";
+    const size_t pos = reply.find(prefix);
+    if (pos == std::string::npos) return false;
+    const size_t ps = pos + prefix.size();
+    return ps < reply.size() && reply[ps] >= '1' && reply[ps] <= '4';
+}
+
+// Optional terminal features, detected once when App::run() starts.
+struct TermCaps {
+    bool sync_output; // DEC private mode 2026: synchronized update
+    bool erase_chars; // ECH (CSI n X): VT220 and later
+    bool repeat_char; // REP (CSI n b): VT420-class terminals
+    bool raw_output;  // LF moves straight down and the last column defers wrap
+
+    TermCaps() : sync_output(false), erase_chars(false), repeat_char(false), raw_output(false) {}
+};
+
+// Returns the conformance level from a DA1 reply (CSI ? Pl ; ... c), e.g.
+// 62 for VT220, 64 for VT420; 0 when reply holds no DA1 report.
+inline int da1_level(const std::string& reply) {
+    const size_t pos = reply.rfind("\033[?");
+    if (pos == std::string::npos || reply.find('c', pos) == std::string::npos) return 0;
+    int level = 0;
+    for (size_t i = pos + 3; i < reply.size() && reply[i] >= '0' && reply[i] <= '9'; ++i)
+        level = level * 10 + (reply[i] - '0');
+    return level;
+}
+
+inline TermCaps probe_terminal(int timeout_ms = 200) {
+    TermCaps caps;
+    const std::string reply = query_terminal("\033[?2026$p", timeout_ms); // DECRQM
+    caps.sync_output = decrqm_recognised(reply, 2026);
+    const int level = da1_level(reply);
+    caps.erase_chars = level >= 62;
+    caps.repeat_char = level >= 64;
+#ifndef _WIN32
+    caps.raw_output = raw_mode_active_ref(); // enter_raw_mode cleared OPOST
+#else
+    caps.raw_output = no_auto_return_ref();
+#endif
+    return caps;
+}
 
 } // namespace detail
 
@@ -638,7 +1464,8 @@ inline void show_cursor() { write_raw("\033[?25h"); }
 class SelectableList {
 public:
     SelectableList()
-        : cursor_(0), cursor_style_(Style().reversed()), multi_select_(false) {}
+        : cursor_(0), cursor_style_(Style().reversed()), multi_select_(false),
+          generation_(detail::next_generation()) {}
     SelectableList(const SelectableList&) = default;
     SelectableList& operator=(const SelectableList&) = default;
     SelectableList(SelectableList&&) noexcept = default;
@@ -649,6 +1476,7 @@ public:
         items_.push_back(item);
         actions_.push_back(std::move(action));
         selected_.push_back(false);
+        touch();
         return *this;
     }
 
@@ -666,8 +1494,8 @@ public:
         return set_on_select(std::move(cb));
     }
 
-    SelectableList& normal_style(const Style& s) { normal_style_ = s; return *this; }
-    SelectableList& cursor_style(const Style& s) { cursor_style_ = s; return *this; }
+    SelectableList& normal_style(const Style& s) { normal_style_ = s; touch(); return *this; }
+    SelectableList& cursor_style(const Style& s) { cursor_style_ = s; touch(); return *this; }
 
     int cursor() const { return cursor_; }
     size_t size() const { return items_.size(); }
@@ -693,6 +1521,7 @@ public:
         on_select_ = nullptr;
         normal_style_ = Style();
         cursor_style_ = Style().reversed();
+        touch();
         return *this;
     }
 
@@ -702,7 +1531,7 @@ public:
         return items_[static_cast<size_t>(cursor_)];
     }
 
-    SelectableList& set_multi_select(bool enabled) { multi_select_ = enabled; return *this; }
+    SelectableList& set_multi_select(bool enabled) { multi_select_ = enabled; touch(); return *this; }
     bool is_multi_select() const { return multi_select_; }
 
     std::vector<std::string> get_selected_items() const {
@@ -715,16 +1544,20 @@ public:
 
     void clear_selection() {
         for (size_t i = 0; i < selected_.size(); ++i) selected_[i] = false;
+        touch();
     }
 
+    // Stamp of the last visible change (items, cursor, checkboxes or styles).
+    uint64_t generation() const { return generation_; }
+
     bool handle_key(detail::Key key) {
         if (items_.empty()) return false;
         switch (key) {
         case detail::KEY_UP:
-            if (cursor_ > 0) { --cursor_; return true; }
+            if (cursor_ > 0) { --cursor_; touch(); return true; }
             return false;
         case detail::KEY_DOWN:
-            if (cursor_ + 1 < static_cast<int>(items_.size())) { ++cursor_; return true; }
+            if (cursor_ + 1 < static_cast<int>(items_.size())) { ++cursor_; touch(); return true; }
             return false;
         case detail::KEY_ENTER:
             if (!actions_.empty() && actions_[static_cast<size_t>(cursor_)])
@@ -736,6 +1569,7 @@ public:
             if (multi_select_) {
                 const size_t idx = static_cast<size_t>(cursor_);
                 if (idx < selected_.size()) selected_[idx] = !selected_[idx];
+                touch();
                 return true;
             }
             return false;
@@ -758,9 +1592,9 @@ public:
                 std::string item_text   = items_[i];
                 const int prefix_width = 6; // "> " (2) + "[x] " (4)
                 if (width > prefix_width) {
-                    int avail = width - prefix_width;
-                    if (static_cast<int>(utf8_display_width(item_text)) > avail)
-                        item_text = utf8_truncate(item_text, static_cast<size_t>(avail));
+                    size_t w;
+                    item_text.resize(detail::utf8_fit(item_text.data(), item_text.size(),
+                                                      static_cast<size_t>(width - prefix_width), w));
                 }
                 Text line;
                 line.add(cursor_mark, st);
@@ -774,8 +1608,10 @@ public:
             content += items_[i];
 
             // Truncate by display width, not raw byte length.
-            if (width > 0 && utf8_display_width(content) > static_cast<size_t>(width))
-                content = utf8_truncate(content, static_cast<size_t>(width));
+            if (width > 0) {
+                size_t w;
+                content.resize(detail::utf8_fit(content.data(), content.size(), static_cast<size_t>(width), w));
+            }
 
             lines.push_back(Text(content, st));
         }
@@ -791,6 +1627,9 @@ private:
     std::function<void(int, const std::string&)> on_select_;
     Style normal_style_;
     Style cursor_style_;
+    uint64_t generation_;
+
+    void touch() { generation_ = detail::next_generation(); }
 };
 
 // ─── Page ───────────────────────────────────────────────────────────────────
@@ -798,7 +1637,12 @@ private:
 class Page {
 public:
     explicit Page(const std::string& title)
-        : title_(title), scroll_(0), has_list_(false), list_() {}
+        : title_(title), title_width_(static_cast<int>(utf8_display_width(title))),
+          scroll_(0), has_list_(false), list_(),
+          generation_(detail::next_generation()), scroll_generation_(generation_),
+          title_generation_(generation_) {
+        detail::note_title_generation(title_generation_);
+    }
     Page(const Page&) = default;
     Page& operator=(const Page&) = default;
     Page(Page&&) noexcept = default;
@@ -806,46 +1650,57 @@ public:
 
     const std::string& title() const { return title_; }
 
+    // Display width of title(), measured once per set_title().
+    int title_width() const { return title_width_; }
+
     Page& set_title(const std::string& t, const Style& s = Style()) {
-        title_ = t; tab_style_ = s; return *this;
+        title_ = t; tab_style_ = s; title_generation_ = detail::next_generation();
+        title_width_ = static_cast<int>(utf8_display_width(t));
+        detail::note_title_generation(title_generation_);
+        return *this;
     }
     const Style& tab_style() const { return tab_style_; }
 
     Page& add_line(const Text& line) {
         lines_.push_back(line);
+        touch();
         return *this;
     }
 
     Page& add_line(const std::string& text) {
         lines_.push_back(Text(text));
+        touch();
         return *this;
     }
 
     Page& add_lines(const std::vector<Text>& lines) {
         for (const Text& line : lines) lines_.push_back(line);
+        touch();
         return *this;
     }
 
     Page& add_blank() {
         lines_.push_back(Text(""));
+        touch();
         return *this;
     }
 
     // Update a single line in-place without clearing the page.
     // Silently ignored if index is out of range.
     Page& update_line(size_t index, const Text& text) {
-        if (index < lines_.size()) lines_[index] = text;
+        if (index < lines_.size()) { lines_[index] = text; touch(); }
         return *this;
     }
 
     // Removes all static lines and resets the scroll position to 0.
-    Page& clear() { lines_.clear(); scroll_ = 0; return *this; }
+    Page& clear() { lines_.clear(); scroll_ = 0; touch(); return *this; }
 
     // Copies list into this Page. The caller's SelectableList may be destroyed
     // freely after this call — Page owns its own copy.
     Page& set_list(const SelectableList& list) {
         list_ = list;
         has_list_ = true;
+        touch();
         return *this;
     }
 
@@ -853,6 +1708,7 @@ public:
     Page& set_list(SelectableList&& list) {
         list_ = std::move(list);
         has_list_ = true;
+        touch();
         return *this;
     }
 
@@ -861,13 +1717,13 @@ public:
     const SelectableList& list() const { return list_; }
 
     void scroll_up(int n = 1) {
-        scroll_ = std::max(0, scroll_ - n);
+        set_scroll(std::max(0, scroll_ - n));
     }
 
     void scroll_down(int n = 1, int visible_rows = 0) {
         int effective_rows = visible_rows > 0 ? visible_rows : total_lines();
         int max_scroll = std::max(0, total_lines() - effective_rows);
-        scroll_ = std::min(scroll_ + n, max_scroll);
+        set_scroll(std::min(scroll_ + n, max_scroll));
     }
 
     int scroll_offset() const { return scroll_; }
@@ -881,65 +1737,912 @@ public:
         return count;
     }
 
+    // Stamp of the last change to anything drawn in the content area: lines,
+    // scroll position or the attached list.  Unchanged stamp → identical frame.
+    uint64_t generation() const {
+        return std::max(content_generation(), scroll_generation_);
+    }
+
+    // Like generation(), but ignoring scroll position changes.  When only
+    // generation() moved, the content area is a pure scroll of the last frame.
+    uint64_t content_generation() const {
+        return has_list_ ? std::max(generation_, list_.generation()) : generation_;
+    }
+
+    // Stamp of the last change to the title or tab style (the tab bar entry).
+    uint64_t title_generation() const { return title_generation_; }
+
 private:
     std::string title_;
+    int title_width_;
     Style tab_style_;
     std::vector<Text> lines_;
     int scroll_;
     bool has_list_;
     SelectableList list_;
+    uint64_t generation_;
+    uint64_t scroll_generation_;
+    uint64_t title_generation_;
+
+    void touch() { generation_ = detail::next_generation(); }
+
+    void set_scroll(int offset) {
+        if (offset != scroll_) { scroll_ = offset; scroll_generation_ = detail::next_generation(); }
+    }
 };
 
-// ─── App ────────────────────────────────────────────────────────────────────
+// ─── Cell Buffer ────────────────────────────────────────────────────────────
 
-class App {
-public:
-    explicit App(const std::string& title = "")
-        : title_(title), active_tab_(0), tab_offset_(0), running_(false), on_tick_() {}
+namespace detail {
 
-    // Register a callback invoked roughly every 100 ms when no key is pressed.
-    // Inside the callback the application has already re-entered the render
-    // cycle, so mutating page content and returning is sufficient — render()
-    // is called automatically after on_tick_() returns.
-    App& set_on_tick(std::function<void()> cb) { on_tick_ = std::move(cb); return *this; }
+// Interns grapheme clusters too long to store in a Cell, so that cells can
+// still be compared by value.  Shared by every buffer and render thread.
+// Entries are never freed; the pool grows only with the number of distinct
+// long clusters (flags, ZWJ emoji sequences) ever drawn.
+class ClusterPool {
+public:
+    uint32_t intern(const char* p, size_t n) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const std::string key(p, n);
+        auto it = ids_.find(key);
+        if (it != ids_.end()) return it->second;
+        const uint32_t id = static_cast<uint32_t>(clusters_.size());
+        clusters_.push_back(key);
+        ids_.emplace(key, id);
+        return id;
+    }
 
-    Page& add_page(const std::string& name) {
-        pages_.push_back(Page(name));
-        return pages_.back();
+    void append(uint32_t id, std::string& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        out += clusters_[id];
     }
 
-    Page& page(size_t index) {
-        assert(index < pages_.size() && "App::page index out of range");
-        return pages_[index];
+private:
+    std::mutex mutex_;
+    std::vector<std::string> clusters_;
+    std::unordered_map<std::string, uint32_t> ids_;
+};
+
+inline ClusterPool& cluster_pool() {
+    static ClusterPool pool;
+    return pool;
+}
+
+// One screen cell: the UTF-8 bytes of a grapheme cluster plus its packed
+// style.  A wide glyph occupies two cells; the right one is a covered cell
+// with no bytes and width 0, drawn along with the left.  Clusters longer
+// than ch are kept in cluster_pool() and the cell holds their id.
+struct Cell {
+    enum : uint8_t { POOLED = 0xFF };
+
+    char     ch[6];
+    uint8_t  len;   // bytes used in ch, or POOLED
+    uint8_t  width; // columns the glyph takes: 1, 2, or 0 when covered
+    uint32_t style; // Style::pack()
+
+    size_t stored() const { return len == POOLED ? sizeof(uint32_t) : len; }
+    uint32_t pool_id() const {
+        uint32_t id;
+        std::memcpy(&id, ch, sizeof(id));
+        return id;
     }
-    Page& active_page() { return pages_[active_tab_]; }
-    size_t page_count() const { return pages_.size(); }
-    size_t active_tab() const { return active_tab_; }
 
-    void set_active_tab(size_t index) {
-        if (index < pages_.size()) active_tab_ = index;
+    bool operator==(const Cell& o) const {
+        return len == o.len && style == o.style && std::memcmp(ch, o.ch, stored()) == 0;
     }
+    bool operator!=(const Cell& o) const { return !(*this == o); }
+};
 
-    void run() {
-        if (pages_.empty()) return;
-        install_signals();
-        detail::enter_raw_mode();
-        detail::hide_cursor();
-        running_ = true;
+inline Cell blank_cell(uint32_t style = 0) {
+    Cell c;
+    c.ch[0] = ' ';
+    c.len   = 1;
+    c.width = 1;
+    c.style = style;
+    return c;
+}
 
-        render();
-        while (running_) {
-            detail::Key key = detail::read_key();
-            if (key == detail::KEY_NONE) {
-                if (on_tick_) { on_tick_(); render(); }
+// Appends the glyph bytes of c.
+inline void append_glyph(std::string& out, const Cell& c) {
+    if (c.len == Cell::POOLED) cluster_pool().append(c.pool_id(), out);
+    else                       out.append(c.ch, c.len);
+}
+
+// A rows × cols grid of cells.  App paints each frame into a back buffer and
+// compares it against the front buffer (what the terminal currently shows)
+// so that only changed cells are written.
+class CellBuffer {
+public:
+    CellBuffer() : cols_(0), rows_(0) {}
+
+    void resize(int cols, int rows) {
+        cols_ = std::max(0, cols);
+        rows_ = std::max(0, rows);
+        cells_.assign(static_cast<size_t>(cols_) * static_cast<size_t>(rows_), blank_cell());
+    }
+
+    void clear() { std::fill(cells_.begin(), cells_.end(), blank_cell()); }
+    void clear_row(int row) {
+        std::fill(cells_.begin() + static_cast<std::ptrdiff_t>(index(row, 0)),
+                  cells_.begin() + static_cast<std::ptrdiff_t>(index(row, 0) + static_cast<size_t>(cols_)),
+                  blank_cell());
+    }
+
+    int cols() const { return cols_; }
+    int rows() const { return rows_; }
+
+    Cell&       at(int row, int col)       { return cells_[index(row, col)]; }
+    const Cell& at(int row, int col) const { return cells_[index(row, col)]; }
+
+    // Fills n cells starting at (row, col) with a single narrow glyph.
+    // Clipped to the row.  Returns the column after the last cell written.
+    int fill(int row, int col, int n, const char* glyph, uint32_t style) {
+        Cell c;
+        c.len   = static_cast<uint8_t>(std::min<size_t>(std::strlen(glyph), sizeof(c.ch)));
+        c.width = 1;
+        c.style = style;
+        std::memcpy(c.ch, glyph, c.len);
+        const int end = std::min(cols_, col + std::max(0, n));
+        if (col >= end) return col;
+        unpair(row, col, end - col);
+        for (; col < end; ++col) at(row, col) = c;
+        return col;
+    }
+
+    // Writes a UTF-8 string starting at (row, col), one grapheme cluster per
+    // cell (two for wide ones), using at most max_cols cells and never going
+    // past the end of the row.  A wide glyph that would not fit is replaced
+    // by a blank.  Invalid bytes are skipped and control characters are
+    // written as spaces so that stray bytes cannot move the terminal cursor.
+    // Returns the column after the last cell written.
+    int put(int row, int col, const std::string& s, uint32_t style, int max_cols) {
+        const int end = std::min(cols_, col + std::max(0, max_cols));
+        const char* p = s.data();
+        size_t i = 0;
+        const size_t len = s.size();
+        while (i < len && col < end) {
+            // ASCII runs: one cell per byte, stored without decoding.  The
+            // byte before a non-ASCII one is left to next_cluster, which may
+            // attach marks to it.
+            size_t run = ascii_prefix(p + i, std::min(len - i, static_cast<size_t>(end - col)));
+            if (run > 0 && i + run < len) --run;
+            if (run > 0) {
+                unpair(row, col, static_cast<int>(run));
+                Cell* c = &at(row, col);
+                for (size_t k = 0; k < run; ++k, ++c) {
+                    const char b = p[i + k];
+                    c->ch[0] = (b < 0x20 || b == 0x7F) ? ' ' : b;
+                    c->len   = 1;
+                    c->width = 1;
+                    c->style = style;
+                }
+                i   += run;
+                col += static_cast<int>(run);
+                if (i >= len || col >= end) break;
+            }
+            int width;
+            const size_t n = next_cluster(p + i, len - i, width);
+            const unsigned char lead = static_cast<unsigned char>(p[i]);
+            const bool control = lead < 0x20 || lead == 0x7F ||
+                                 (lead == 0xC2 && n > 1 && static_cast<unsigned char>(p[i + 1]) < 0xA0);
+            if (width == 0) {
+                // nothing to draw
+            } else if (control || col + width > end) {
+                unpair(row, col, 1);
+                at(row, col++) = blank_cell(style);
+            } else {
+                put_glyph(row, col, p + i, n, width, style);
+                col += width;
+            }
+            i += n;
+        }
+        return col;
+    }
+
+    // Shifts rows [top, bottom] up by n (down when n < 0), filling the rows
+    // exposed at the other end with blanks — the same effect CSI S / CSI T
+    // have inside a scroll region.
+    void scroll(int top, int bottom, int n) {
+        const int height = bottom - top + 1;
+        if (n == 0 || height <= 0) return;
+        const size_t width = static_cast<size_t>(cols_);
+        auto row_begin = [&](int row) { return cells_.begin() + static_cast<std::ptrdiff_t>(index(row, 0)); };
+        if (std::abs(n) >= height) {
+            std::fill(row_begin(top), row_begin(bottom) + static_cast<std::ptrdiff_t>(width), blank_cell());
+        } else if (n > 0) {
+            std::copy(row_begin(top + n), row_begin(bottom) + static_cast<std::ptrdiff_t>(width), row_begin(top));
+            std::fill(row_begin(bottom - n + 1), row_begin(bottom) + static_cast<std::ptrdiff_t>(width), blank_cell());
+        } else {
+            std::copy_backward(row_begin(top), row_begin(bottom + n) + static_cast<std::ptrdiff_t>(width),
+                               row_begin(bottom) + static_cast<std::ptrdiff_t>(width));
+            std::fill(row_begin(top), row_begin(top - n), blank_cell());
+        }
+    }
+
+    // 64-bit FNV-1a hash of a row's glyphs and styles, for spotting rows
+    // that moved between frames.
+    uint64_t row_hash(int row) const {
+        uint64_t h = 14695981039346656037ull;
+        auto mix = [&h](uint32_t v) {
+            for (int i = 0; i < 4; ++i) {
+                h ^= (v >> (8 * i)) & 0xFFu;
+                h *= 1099511628211ull;
+            }
+        };
+        const Cell* c = &at(row, 0);
+        for (int col = 0; col < cols_; ++col, ++c) {
+            for (size_t i = 0; i < c->stored(); ++i) { // bytes past that are unset
+                h ^= static_cast<unsigned char>(c->ch[i]);
+                h *= 1099511628211ull;
+            }
+            mix(c->style | static_cast<uint32_t>(c->len) << 24);
+        }
+        return h;
+    }
+
+    // Paints every span of t starting at (row, col), truncated to max_cols.
+    // Span styles are ANDed with style_mask (see Style::pack()).
+    int put(int row, int col, const Text& t, int max_cols, uint32_t style_mask = ~0u) {
+        const int end = col + std::max(0, max_cols);
+        for (const TextSpan& span : t.spans()) {
+            if (col >= end) break;
+            col = put(row, col, span.content, span.style.pack() & style_mask, end - col);
+        }
+        return col;
+    }
+
+    // Paints t like put() and pads the rest of the width cells with default
+    // blanks, so every cell of [col, col + width) is written exactly once.
+    int put_line(int row, int col, const Text& t, int width, uint32_t style_mask = ~0u) {
+        const int end = std::min(cols_, col + std::max(0, width));
+        col = put(row, col, t, end - col, style_mask);
+        return fill(row, col, end - col, " ", 0);
+    }
+
+private:
+    int cols_;
+    int rows_;
+    std::vector<Cell> cells_;
+
+    size_t index(int row, int col) const {
+        assert(row >= 0 && row < rows_ && col >= 0 && col < cols_);
+        return static_cast<size_t>(row) * static_cast<size_t>(cols_) + static_cast<size_t>(col);
+    }
+
+    // Stores an n-byte cluster of the given width at (row, col), followed by
+    // a covered cell when it is wide.  The cluster must fit in the row.
+    void put_glyph(int row, int col, const char* p, size_t n, int width, uint32_t style) {
+        unpair(row, col, width);
+        Cell& c = at(row, col);
+        if (n <= sizeof(c.ch)) {
+            std::memcpy(c.ch, p, n);
+            c.len = static_cast<uint8_t>(n);
+        } else {
+            const uint32_t id = cluster_pool().intern(p, n);
+            std::memcpy(c.ch, &id, sizeof(id));
+            c.len = Cell::POOLED;
+        }
+        c.width = static_cast<uint8_t>(width);
+        c.style = style;
+        if (width == 2) {
+            Cell& covered = at(row, col + 1);
+            covered.len   = 0;
+            covered.width = 0;
+            covered.style = style;
+        }
+    }
+
+    // Before cells [col, col + n) of a row are overwritten, blanks the other
+    // half of any wide glyph the write would cut in two, as a terminal does.
+    void unpair(int row, int col, int n) {
+        if (at(row, col).width == 0 && col > 0)
+            at(row, col - 1) = blank_cell(at(row, col - 1).style);
+        const int last = col + n - 1;
+        if (at(row, last).width == 2 && last + 1 < cols_)
+            at(row, last + 1) = blank_cell(at(row, last + 1).style);
+    }
+};
+
+// Small fixed-capacity byte string for building candidate escape sequences
+// without touching the heap.
+struct EscSeq {
+    char   b[32];
+    size_t n;
+
+    EscSeq() : n(0) {}
+
+    void ch(char c) { if (n < sizeof(b)) b[n++] = c; }
+    void num(int v) {
+        char digits[12];
+        int k = 0;
+        do { digits[k++] = static_cast<char>('0' + v % 10); v /= 10; } while (v > 0);
+        while (k > 0) ch(digits[--k]);
+    }
+    // CSI <v> <final>; a parameter of 1 is the default and is omitted.
+    void csi(int v, char final) {
+        ch('\033'); ch('[');
+        if (v != 1) num(v);
+        ch(final);
+    }
+    void repeat(char c, int count) { for (int i = 0; i < count; ++i) ch(c); }
+    void append(const EscSeq& o) { for (size_t i = 0; i < o.n; ++i) ch(o.b[i]); }
+};
+
+// Appends escape sequences to a frame while tracking the terminal's current
+// attributes and cursor position.  Style changes cost only the SGR delta
+// between runs, and each cursor jump uses the cheapest of absolute (CUP),
+// relative (CUU/CUD/CUF/CUB), CR/LF/BS, column/row-absolute (CHA/VPA) or
+// simply re-sending the few cells in between.  Runs of identical cells are
+// compressed with EL, ECH or REP when the terminal supports them.  LF, and
+// relative moves after writing the last column, are used only when
+// TermCaps::raw_output says the terminal honours them.  A frame starts in
+// the default style with an unknown cursor position and ends in the default
+// style.
+class FrameEncoder {
+public:
+    FrameEncoder(std::string& out, int cols, const TermCaps& caps = TermCaps())
+        : out_(out), caps_(caps), cols_(cols), style_(0), row_(0), col_(0),
+          known_(false), wrap_pending_(false) {}
+
+    void set_style(uint32_t style) {
+        Style::append_transition(out_, style_, style);
+        style_ = style;
+    }
+
+    // Writes c at the cursor.  A covered cell writes nothing: the wide
+    // glyph to its left already drew both columns.
+    void put(const Cell& c) {
+        if (c.width == 0) return;
+        set_style(c.style);
+        append_glyph(out_, c);
+        advance(c.width);
+    }
+
+    // Writes line[col] at the cursor, which must be at col, together with the
+    // identical cells that follow it when a compact encoding is cheaper than
+    // the literal bytes: EL for blanks reaching the end of the row, ECH for
+    // other blank runs, REP for any other repeated single-codepoint glyph.
+    // Returns the number of cells written (at least 1).
+    int put_run(const Cell* line, int col) {
+        const Cell& c = line[col];
+        int n = 1;
+        while (col + n < cols_ && line[col + n] == c) ++n;
+        if (n == 1) { put(c); return 1; }
+
+        // Erased cells take the default attributes, so only plain blanks
+        // qualify (bold and fg make no visible difference on a space).
+        const bool erasable = c.len == 1 && c.ch[0] == ' ' && (c.style & ~0xF9u) == 0;
+        if (erasable && col + n == cols_ && n > 3) { // EL is 3 bytes
+            set_style(c.style);
+            out_.append("\033[K");
+            return n; // EL does not move the cursor
+        }
+        if (erasable && caps_.erase_chars) {
+            EscSeq ech, skip;
+            ech.csi(n, 'X');
+            skip.csi(n, 'C');
+            if (ech.n + skip.n < static_cast<size_t>(n)) {
+                set_style(c.style);
+                out_.append(ech.b, ech.n);
+                move_to(row_, col + n); // ECH does not move the cursor either
+                return n;
+            }
+        }
+        // REP repeats only the last codepoint sent, not a whole cluster.
+        if (caps_.repeat_char && c.len != Cell::POOLED && utf8_char_len(c.ch, c.len) == c.len) {
+            EscSeq rep;
+            rep.csi(n - 1, 'b');
+            if (c.len + rep.n < static_cast<size_t>(n) * c.len) {
+                put(c);
+                out_.append(rep.b, rep.n);
+                advance(n - 1);
+                return n;
+            }
+        }
+        put(c);
+        return 1;
+    }
+
+    // Moves the cursor to (row, col).  `line`, when given, is the target row
+    // as currently shown on screen; cells between the cursor and col may then
+    // be re-sent instead of emitting a motion sequence if that is cheaper.
+    void move_to(int row, int col, const Cell* line = nullptr) {
+        if (known_ && !wrap_pending_ && row == row_ && col == col_) return;
+
+        EscSeq best;
+        best.ch('\033'); best.ch('[');
+        if (row > 0 || col > 0) best.num(row + 1);
+        if (col > 0) { best.ch(';'); best.num(col + 1); }
+        best.ch('H');
+
+        // Without deferred wrap, writing the last column may already have
+        // moved the cursor to the next row, so only an absolute move is safe.
+        if (known_ && (!wrap_pending_ || caps_.raw_output)) {
+            const EscSeq v = vertical(row);
+            const EscSeq h = horizontal(col);
+            if (v.n + h.n < best.n) {
+                best = v;
+                best.append(h);
+            }
+            if (line && row == row_ && !wrap_pending_ && col > col_ &&
+                rewrite(line, col, best.n))
+                return;
+        }
+
+        out_.append(best.b, best.n);
+        row_ = row;
+        col_ = col;
+        known_ = true;
+        wrap_pending_ = false;
+    }
+
+    // Scrolls screen rows [top, bottom] up by n (down when n < 0) using a
+    // temporary DECSTBM scroll region and SU/SD.  The rows that scroll in are
+    // blank in the default style.  DECSTBM homes the cursor, so its position
+    // is unknown afterwards.
+    void scroll_region(int top, int bottom, int n) {
+        if (n == 0) return;
+        set_style(0); // scrolled-in rows take the current background
+        EscSeq seq;
+        seq.ch('\033'); seq.ch('[');
+        seq.num(top + 1); seq.ch(';'); seq.num(bottom + 1);
+        seq.ch('r');
+        seq.csi(n > 0 ? n : -n, n > 0 ? 'S' : 'T');
+        seq.ch('\033'); seq.ch('['); seq.ch('r');
+        out_.append(seq.b, seq.n);
+        known_ = false;
+        wrap_pending_ = false;
+    }
+
+    // Returns the terminal to the default style.
+    void finish() { set_style(0); }
+
+private:
+    std::string& out_;
+    TermCaps caps_;
+    int cols_;
+    uint32_t style_;
+    int row_;
+    int col_;
+    bool known_;        // false until the first absolute move
+    bool wrap_pending_; // cursor sits past the last column
+
+    void advance(int n) {
+        col_ += n;
+        if (col_ >= cols_) {
+            // Writing the last column leaves the cursor in the terminal's
+            // deferred-wrap state, where relative column moves are unreliable.
+            col_ = cols_ - 1;
+            wrap_pending_ = true;
+        }
+    }
+
+    // Cheapest way to reach `row` without changing the column.
+    EscSeq vertical(int row) const {
+        EscSeq best, alt;
+        if (row == row_) return best;
+        best.csi(row + 1, 'd'); // VPA
+        const int d = row - row_;
+        if (d > 0) alt.csi(d, 'B'); else alt.csi(-d, 'A');
+        if (alt.n < best.n) best = alt;
+        if (caps_.raw_output && d > 0 && d < static_cast<int>(best.n)) { // LF, no CR
+            alt.n = 0;
+            alt.repeat('\n', d);
+            best = alt;
+        }
+        return best;
+    }
+
+    // Cheapest way to reach `col` on the current row.
+    EscSeq horizontal(int col) const {
+        EscSeq best, alt;
+        best.csi(col + 1, 'G'); // CHA
+        alt.ch('\r');
+        if (col > 0) alt.csi(col, 'C');
+        if (alt.n < best.n) best = alt;
+        if (wrap_pending_) return best;
+        if (col == col_) return EscSeq();
+        const int d = col - col_;
+        alt.n = 0;
+        if (d > 0) alt.csi(d, 'C'); else alt.csi(-d, 'D');
+        if (alt.n < best.n) best = alt;
+        if (d < 0 && -d < static_cast<int>(best.n)) {
+            alt.n = 0;
+            alt.repeat('\b', -d);
+            best = alt;
+        }
+        return best;
+    }
+
+    // Re-sends line[col_, col) when every cell already has the current style
+    // and the bytes cost less than `budget`.  Returns true if it did.
+    bool rewrite(const Cell* line, int col, size_t budget) {
+        size_t cost = 0;
+        for (int c = col_; c < col; ++c) {
+            if (line[c].len == Cell::POOLED || line[c].style != style_) return false;
+            cost += line[c].len;
+            if (cost >= budget) return false;
+        }
+        for (int c = col_; c < col; ++c) out_.append(line[c].ch, line[c].len);
+        col_ = col;
+        return true;
+    }
+};
+
+// A block move: scroll rows [top, bottom] up by n, or down by -n when n < 0.
+struct RowShift {
+    int top;
+    int bottom;
+    int n;
+};
+
+// Number of cells in `row` that differ between a and b.
+inline int row_diff_cells(const CellBuffer& a, const CellBuffer& b, int row) {
+    const Cell* x = &a.at(row, 0);
+    const Cell* y = &b.at(row, 0);
+    int n = 0;
+    for (int col = 0; col < a.cols(); ++col) n += x[col] != y[col];
+    return n;
+}
+
+// Number of cells in `row` of a that are not default blanks.
+inline int row_ink_cells(const CellBuffer& a, int row) {
+    const Cell* x = &a.at(row, 0);
+    const Cell blank = blank_cell();
+    int n = 0;
+    for (int col = 0; col < a.cols(); ++col) n += x[col] != blank;
+    return n;
+}
+
+// Finds the block move that best turns the screen rows hashed in `from`
+// into the new frame's rows hashed in `to`: a run of rows [a, b] with
+// to[y] == from[y + d] for some shift d != 0, moved with a scroll of rows
+// [top, bottom].  Savings are counted in cells: the run's rows no longer
+// need their stay_cost[y] cells repainted, while each row that scrolls in
+// blank needs ink_cost[y] cells painted instead of stay_cost[y].  Returns
+// false unless the best move saves at least min_gain cells.  O(rows^2),
+// which is cheap next to the cell diff for any real terminal height.
+inline bool find_row_shift(const std::vector<uint64_t>& from, const std::vector<uint64_t>& to,
+                           const std::vector<int>& stay_cost, const std::vector<int>& ink_cost,
+                           int min_gain, RowShift& best) {
+    const int m = static_cast<int>(std::min(from.size(), to.size()));
+    int best_gain = min_gain - 1;
+    bool found = false;
+    for (int d = 1 - m; d < m; ++d) {
+        if (d == 0) continue;
+        const int lo = std::max(0, -d);
+        const int hi = std::min(m, m - d);
+        int a = lo;
+        int gain = 0;
+        for (int y = lo; y <= hi; ++y) {
+            if (y < hi && to[static_cast<size_t>(y)] == from[static_cast<size_t>(y + d)]) {
+                gain += stay_cost[static_cast<size_t>(y)];
+                continue;
+            }
+            // Run [a, y - 1] ended; the rows scrolled in are those just past it.
+            if (y > a && gain > best_gain) {
+                const int b = y - 1;
+                const int exposed_first = d > 0 ? b + 1 : a + d;
+                const int exposed_last  = d > 0 ? b + d : a - 1;
+                int net = gain;
+                for (int e = exposed_first; e <= exposed_last; ++e)
+                    net -= ink_cost[static_cast<size_t>(e)] - stay_cost[static_cast<size_t>(e)];
+                if (net > best_gain) {
+                    best_gain   = net;
+                    best.top    = d > 0 ? a : a + d;
+                    best.bottom = d > 0 ? b + d : b;
+                    best.n      = d;
+                    found       = true;
+                }
+            }
+            a = y + 1;
+            gain = 0;
+        }
+    }
+    return found;
+}
+
+// Appends the escape sequences that turn rows [first, last) of `front` into
+// those of `back` to enc, and copies them into front.  Only runs of changed
+// cells are emitted, joined by the cheapest cursor motion.  Touches no other
+// rows, so disjoint ranges may be encoded concurrently.
+inline void encode_rows(CellBuffer& front, const CellBuffer& back, FrameEncoder& enc,
+                        int first, int last) {
+    assert(front.cols() == back.cols() && front.rows() == back.rows());
+    const int cols = back.cols();
+    for (int row = first; row < last; ++row) {
+        int col = 0;
+        while (col < cols) {
+            if (front.at(row, col) == back.at(row, col)) { ++col; continue; }
+            const Cell* line = &back.at(row, 0);
+            enc.move_to(row, col, line);
+            while (col < cols && front.at(row, col) != back.at(row, col)) {
+                const int n = enc.put_run(line, col);
+                std::copy(line + col, line + col + n, &front.at(row, col));
+                col += n;
+            }
+        }
+    }
+}
+
+// Appends the escape sequences that turn `front` into `back` to enc, then
+// copies back into front.  Both buffers must have equal size.
+inline void encode_diff(CellBuffer& front, const CellBuffer& back, FrameEncoder& enc) {
+    encode_rows(front, back, enc, 0, back.rows());
+    enc.finish();
+}
+
+// ─── Row Workers ────────────────────────────────────────────────────────────
+
+#ifdef TERMUI_THREADS
+
+// A small pool of helper threads that App uses to paint and encode bands of
+// rows concurrently on very large terminals.  run() hands out task indices
+// to the helpers and the calling thread alike and returns once every task
+// has finished, so tasks may freely reference the caller's locals.
+class RowWorkers {
+public:
+    RowWorkers() : task_(nullptr), count_(0), next_(0), job_(0), busy_(0), stop_(false) {}
+    ~RowWorkers() { resize(0); }
+
+    RowWorkers(const RowWorkers&) = delete;
+    RowWorkers& operator=(const RowWorkers&) = delete;
+
+    // Sets the number of helper threads.  Must not be called during run().
+    void resize(int n) {
+        n = std::max(0, n);
+        if (static_cast<size_t>(n) == threads_.size()) return;
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& t : threads_) t.join();
+        threads_.clear();
+        stop_ = false;
+        for (int i = 0; i < n; ++i) threads_.emplace_back(&RowWorkers::loop, this, job_);
+    }
+
+    int size() const { return static_cast<int>(threads_.size()); }
+
+    // Calls task(i) once for every i in [0, n).
+    void run(int n, const std::function<void(int)>& task) {
+        if (threads_.empty() || n <= 1) {
+            for (int i = 0; i < n; ++i) task(i);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            task_  = &task;
+            count_ = n;
+            next_  = 0;
+            busy_  = threads_.size();
+            ++job_;
+        }
+        wake_.notify_all();
+        work();
+        std::unique_lock<std::mutex> lk(mutex_);
+        done_.wait(lk, [this] { return busy_ == 0; });
+        task_ = nullptr;
+    }
+
+private:
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_;  // a job was posted or stop_ was set
+    std::condition_variable done_;  // the last helper left the current job
+    const std::function<void(int)>* task_;
+    int count_;
+    std::atomic<int> next_;         // next task index to hand out
+    uint64_t job_;                  // bumped for every posted job
+    size_t busy_;                   // helpers still inside the current job
+    bool stop_;
+
+    void work() {
+        for (int i = next_++; i < count_; i = next_++) (*task_)(i);
+    }
+
+    void loop(uint64_t seen) {
+        std::unique_lock<std::mutex> lk(mutex_);
+        for (;;) {
+            wake_.wait(lk, [&] { return stop_ || job_ != seen; });
+            if (stop_) return;
+            seen = job_;
+            lk.unlock();
+            work();
+            lk.lock();
+            if (--busy_ == 0) done_.notify_one();
+        }
+    }
+};
+
+#else // !TERMUI_THREADS
+
+// Serial stand-in used when TERMUI_THREADS is not defined: never starts a
+// thread, and run() calls every task on the calling thread.
+class RowWorkers {
+public:
+    void resize(int) {}
+    int size() const { return 0; }
+    void run(int n, const std::function<void(int)>& task) {
+        for (int i = 0; i < n; ++i) task(i);
+    }
+};
+
+#endif // TERMUI_THREADS
+
+} // namespace detail
+
+// ─── App ────────────────────────────────────────────────────────────────────
+
+class App {
+public:
+    explicit App(const std::string& title = "")
+        : title_(title), active_tab_(0), tab_offset_(0), running_(false), on_tick_(),
+          front_valid_(false), tabs_generation_(0), drawn_tabs_(0), drawn_page_(0),
+          drawn_content_(0), drawn_tab_index_(0), drawn_scroll_(0),
+          tab_prefix_generation_(0), goto_active_(false),
+          frame_interval_(0), frame_pending_(false), focused_(true), unfocused_tick_ms_(1000),
+          size_(), resize_pending_(false),
+          sync_output_(true), probe_timeout_ms_(200), bandwidth_(0), lean_(false), restyle_pending_(false), latency_probe_(false),
+          probe_outstanding_(false), rtt_(0), render_threads_(1),
+          chrome_key_(), chrome_valid_(false), yields_(0) {}
+
+    // Register a callback invoked roughly every 100 ms when no key is pressed.
+    // Inside the callback the application has already re-entered the render
+    // cycle, so mutating page content and returning is sufficient — render()
+    // is called automatically after on_tick_() returns.
+    App& set_on_tick(std::function<void()> cb) { on_tick_ = std::move(cb); return *this; }
+
+    // Tick period while the terminal window is unfocused, on terminals that
+    // report focus changes (mode 1004).  0 suspends ticks and rendering
+    // until focus returns.  Default: 1000 ms.  On focus-in the app ticks
+    // and repaints the whole screen immediately.
+    App& set_unfocused_tick_interval(int ms) { unfocused_tick_ms_ = std::max(0, ms); return *this; }
+
+    // Wraps each frame in a synchronized update (DEC private mode 2026) so
+    // the terminal shows it atomically instead of repainting mid-frame.
+    // Enabled by default; only takes effect when the terminal reports the
+    // mode via DECRQM at startup.
+    App& set_synchronized_output(bool enabled) { sync_output_ = enabled; return *this; }
+
+    // How long run() waits at startup for the terminal to answer its
+    // feature queries (synchronized output, ECH, REP).  Features whose
+    // answer misses the deadline stay off.  Raise it on high-latency links
+    // such as satellite or serial connections.  Default: 200 ms.
+    App& set_probe_timeout(int ms) { probe_timeout_ms_ = std::max(0, ms); return *this; }
+
+    // Caps rendering at fps frames per second (0 = unlimited, the default).
+    // Keys and ticks still update state immediately; frames requested within
+    // one interval of the previous frame are coalesced into a single frame
+    // drawn when the interval ends, so the latest state always reaches the
+    // screen.
+    App& set_max_fps(int fps) {
+        frame_interval_ = fps > 0 ? std::chrono::milliseconds(1000 / fps)
+                                  : std::chrono::milliseconds(0);
+        return *this;
+    }
+
+    // Paints and encodes frames on up to n threads (the UI thread plus n - 1
+    // helpers started by run()), each taking a band of rows.  Meant for very
+    // large terminals, where per-frame work grows with the cell count; the
+    // default of 1 keeps all rendering on the UI thread.  Callbacks still
+    // run only on the UI thread.  Has no effect unless TERMUI_THREADS is
+    // defined (see the top of this file).
+    App& set_render_threads(int n) { render_threads_ = std::max(1, n); return *this; }
+
+    // Limits output to about bytes_per_second (0 = unlimited, the default),
+    // for slow links such as serial consoles.  Frames are spaced so the
+    // link can drain each one before the next is drawn, and while frames
+    // take longer than a quarter second to send, borders and text are
+    // drawn without colours (bold, underline and reverse are kept) until
+    // the link has been keeping up for a few seconds.
+    App& set_bandwidth_limit(int bytes_per_second) {
+        bandwidth_ = std::max(0, bytes_per_second);
+        return *this;
+    }
+
+    // Periodically measures the terminal's round-trip time with a DSR
+    // cursor-position query and never starts a frame sooner than one round
+    // trip after the previous one, so queued output cannot pile up on a
+    // high-latency link.  Off by default; probing stops if the terminal
+    // does not answer.
+    App& set_latency_probe(bool enabled) { latency_probe_ = enabled; return *this; }
+
+    Page& add_page(const std::string& name) {
+        pages_.push_back(Page(name));
+        tabs_generation_ = detail::next_generation();
+        return pages_.back();
+    }
+
+    Page& page(size_t index) {
+        assert(index < pages_.size() && "App::page index out of range");
+        return pages_[index];
+    }
+    Page& active_page() { return pages_[active_tab_]; }
+    size_t page_count() const { return pages_.size(); }
+    size_t active_tab() const { return active_tab_; }
+
+    void set_active_tab(size_t index) {
+        if (index < pages_.size() && index != active_tab_) {
+            active_tab_ = index;
+            tabs_generation_ = detail::next_generation();
+        }
+    }
+
+    void run() {
+        if (pages_.empty()) return;
+        install_signals();
+        detail::enter_raw_mode();
+        caps_ = detail::probe_terminal(probe_timeout_ms_);
+        detail::enter_alt_screen();
+        detail::hide_cursor();
+        detail::enable_focus_events();
+        out_.enable();
+        workers_.resize(render_threads_ - 1);
+        running_ = true;
+        size_ = detail::get_terminal_size();
+        resize_pending_ = false;
+
+        focused_ = true;
+        render();
+        last_frame_ = Clock::now();
+        Clock::time_point next_tick = last_frame_ + tick_period();
+        while (running_) {
+            // Sleep until the next tick, or until a deferred frame is due.
+            Clock::time_point wake = next_tick;
+            // While the terminal is backlogged, stdout becoming writable is
+            // the wake-up instead; while a resize settles, its deadline is.
+            // Suspended, the frame waits for focus-in.
+            if (frame_pending_ && !out_.busy() && !resize_pending_ && !ticks_suspended())
+                wake = std::min(wake, next_frame_time());
+            if (resize_pending_) wake = std::min(wake, resize_deadline_);
+            // Leaving lean mode takes a frame, which cannot start before
+            // next_frame_time().
+            if (lean_) wake = std::min(wake, std::max(lean_until_, next_frame_time()));
+            if (latency_probe_) {
+                probe_latency();
+                wake = std::min(wake, probe_outstanding_ ? probe_sent_ + PROBE_TIMEOUT()
+                                                         : next_probe_);
+            }
+            detail::Key key = detail::read_key(millis_until(wake), out_.busy());
+            if (out_.busy()) out_.flush();
+
+            // A burst of resize events has gone quiet: take the new size
+            // and repaint once.
+            if (resize_pending_ && Clock::now() >= resize_deadline_) {
+                resize_pending_ = false;
+                size_ = detail::get_terminal_size();
+                front_valid_ = false; // terminal may have reflowed; repaint everything
+            }
+
+            if (key == detail::KEY_NONE) {
+                if (Clock::now() >= next_tick) {
+                    if (on_tick_ && !ticks_suspended()) on_tick_();
+                    next_tick = Clock::now() + tick_period();
+                }
+            } else if (key == detail::KEY_FOCUS_IN || key == detail::KEY_FOCUS_OUT) {
+                const bool was_focused = focused_;
+                focused_ = key == detail::KEY_FOCUS_IN;
+                if (focused_ && !was_focused) {
+                    // Catch up at once with a tick and a full repaint.
+                    if (on_tick_) on_tick_();
+                    front_valid_ = false;
+                }
+                next_tick = Clock::now() + tick_period();
             } else {
                 handle_key(key);
+                next_tick = Clock::now() + tick_period();
             }
+            if (running_) refresh();
         }
 
+        // Leaving the alternate screen restores whatever the shell showed.
+        workers_.resize(0);
+        out_.disable();
+        detail::disable_focus_events();
         detail::show_cursor();
-        detail::clear_screen();
-        detail::move_cursor(0, 0);
+        detail::exit_alt_screen();
         detail::exit_raw_mode();
     }
 
@@ -953,6 +2656,267 @@ private:
     size_t tab_offset_;
     bool running_;
     std::function<void()> on_tick_;
+    detail::CellBuffer front_; // what the terminal currently shows
+    detail::CellBuffer back_;  // frame being composed
+    bool front_valid_;         // false until the screen has been cleared once
+    // Dirty tracking: stamps of the tab bar and active page as of the last
+    // frame.  A tick whose stamps match draws nothing.
+    uint64_t tabs_generation_; // bumped on add_page, tab switches and prompt edits
+    uint64_t drawn_tabs_;
+    uint64_t drawn_page_;
+    // Scroll detection: the content stamp, tab and offset of the last frame.
+    uint64_t drawn_content_;
+    size_t   drawn_tab_index_;
+    int      drawn_scroll_;
+    // Revision of the Text painted on each back-buffer row, so content rows
+    // whose line is unchanged are not repainted.  Revisions start at 1.
+    enum : uint64_t { ROW_BLANK = 0, ROW_UNPAINTED = ~static_cast<uint64_t>(0) };
+    std::vector<uint64_t> row_src_;
+    // Per-row hashes of the content area, reused across frames (see render).
+    std::vector<uint64_t> hash_front_;
+    std::vector<uint64_t> hash_back_;
+    std::vector<int>      stay_cost_;
+    std::vector<int>      ink_cost_;
+
+    // Newest title or tab-style change across all pages, in O(1).  Pages of
+    // other Apps count too, which at worst costs one needless relayout.
+    uint64_t titles_generation() const {
+        return detail::newest_title_ref().load(std::memory_order_relaxed);
+    }
+
+    uint64_t tab_generation() const { return std::max(tabs_generation_, titles_generation()); }
+
+    // Tab bar layout.  tab_prefix_[i] is the number of columns taken by tabs
+    // [0, i), each counted as " title " plus one separator, so the width of
+    // any run of tabs is a difference of two entries.  Rebuilt from the
+    // titles' cached widths when a page is added or retitled.
+    std::vector<int> tab_prefix_;
+    uint64_t         tab_prefix_generation_;
+
+    void update_tab_prefix() {
+        const uint64_t g = titles_generation();
+        if (tab_prefix_.size() == pages_.size() + 1 && tab_prefix_generation_ == g) return;
+        tab_prefix_.resize(pages_.size() + 1);
+        tab_prefix_[0] = 0;
+        for (size_t i = 0; i < pages_.size(); ++i)
+            tab_prefix_[i + 1] = tab_prefix_[i] + pages_[i].title_width() + 3;
+        tab_prefix_generation_ = g;
+    }
+
+    // Returns the index of the last tab that fits when the bar starts at
+    // `offset` within `budget` display columns.  Every tab but the last must
+    // also leave room for the ' >' indicator.  Always returns at least
+    // `offset`.  O(log n); requires update_tab_prefix().
+    size_t last_visible_tab(size_t offset, int budget) const {
+        const size_t n = pages_.size();
+        if (offset + 1 >= n) return offset;
+        // Columns taken by tabs [offset, last] and the separators between them.
+        auto span = [&](size_t last) { return tab_prefix_[last + 1] - tab_prefix_[offset] - 1; };
+        size_t lo = offset, hi = n - 2;
+        while (lo < hi) {
+            const size_t mid = lo + (hi - lo + 1) / 2;
+            if (span(mid) + 2 <= budget) lo = mid; else hi = mid - 1;
+        }
+        if (lo == n - 2 && span(n - 1) <= budget) return n - 1;
+        return lo;
+    }
+
+    // Go-to-tab prompt (KEY_GOTO), shown in the bottom border while open.
+    bool        goto_active_;
+    std::string goto_input_;
+
+    void goto_key(detail::Key key) {
+        switch (key) {
+        case detail::KEY_ESCAPE:
+            goto_active_ = false;
+            break;
+        case detail::KEY_ENTER:
+            goto_active_ = false;
+            goto_tab(goto_input_);
+            break;
+        case detail::KEY_BACKSPACE:
+            // Drop one whole UTF-8 character.
+            while (!goto_input_.empty()) {
+                const unsigned char b = static_cast<unsigned char>(goto_input_.back());
+                goto_input_.pop_back();
+                if ((b & 0xC0) != 0x80) break;
+            }
+            break;
+        case detail::KEY_CHAR:
+        case detail::KEY_QUIT:
+        case detail::KEY_SPACE:
+        case detail::KEY_GOTO:
+            goto_input_ += detail::last_char();
+            break;
+        default:
+            return;
+        }
+        tabs_generation_ = detail::next_generation(); // redraw the prompt
+    }
+
+    // Switches to tab number `query` (1-based) if it is all digits,
+    // otherwise to the next tab after the active one whose title starts
+    // with `query`, ignoring ASCII case.
+    void goto_tab(const std::string& query) {
+        if (query.empty()) return;
+        if (query.find_first_not_of("0123456789") == std::string::npos) {
+            size_t n = 0;
+            for (char c : query) {
+                n = n * 10 + static_cast<size_t>(c - '0');
+                if (n > pages_.size()) return;
+            }
+            if (n > 0) set_active_tab(n - 1);
+            return;
+        }
+        auto lower = [](char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; };
+        for (size_t k = 1; k <= pages_.size(); ++k) {
+            const size_t i = (active_tab_ + k) % pages_.size();
+            const std::string& t = pages_[i].title();
+            if (t.size() < query.size()) continue;
+            size_t j = 0;
+            while (j < query.size() && lower(t[j]) == lower(query[j])) ++j;
+            if (j == query.size()) { set_active_tab(i); return; }
+        }
+    }
+
+    bool frame_dirty() const {
+        return !front_valid_
+            || tab_generation() != drawn_tabs_
+            || pages_[active_tab_].generation() != drawn_page_
+            || lean_ != want_lean();
+    }
+
+    // Frame pacing (see set_max_fps).
+    typedef std::chrono::steady_clock Clock;
+    Clock::duration   frame_interval_;
+    Clock::time_point last_frame_;
+    bool              frame_pending_; // a dirty frame is waiting for its slot
+
+    // Focus tracking (see set_unfocused_tick_interval).  Starts focused, so
+    // terminals without focus reports behave as before.
+    bool focused_;
+    int  unfocused_tick_ms_;
+
+    Clock::duration tick_period() const {
+        if (focused_) return std::chrono::milliseconds(100);
+        if (unfocused_tick_ms_ > 0) return std::chrono::milliseconds(unfocused_tick_ms_);
+        return std::chrono::hours(1); // suspended; only wakes the loop
+    }
+
+    // Unfocused with an unfocused tick interval of 0: no ticks and no
+    // rendering until focus-in.
+    bool ticks_suspended() const { return !focused_ && unfocused_tick_ms_ == 0; }
+
+    // Terminal size, read at startup and after each burst of resize events
+    // rather than once per frame.  Resize events arriving less than
+    // RESIZE_QUIET_MS apart (a window being dragged) are coalesced into one
+    // re-layout.
+    enum { RESIZE_QUIET_MS = 50 };
+    detail::TermSize  size_;
+    bool              resize_pending_;
+    Clock::time_point resize_deadline_;
+
+    detail::TermCaps caps_; // filled in by run()
+    bool sync_output_;      // user opt-in for synchronized updates
+    int  probe_timeout_ms_; // see set_probe_timeout
+
+    // Slow-link mode (see set_bandwidth_limit and set_latency_probe).
+    int               bandwidth_;      // bytes per second; 0 = unlimited
+    Clock::time_point link_free_at_;   // when the link should have sent all output
+    Clock::time_point lean_until_;     // colourless drawing is wanted until then
+    bool              lean_;           // the back buffer is drawn colourless
+    bool              restyle_pending_; // lean_ flipped; cleared once that frame is submitted
+    bool              latency_probe_;
+    bool              probe_outstanding_;
+    Clock::time_point probe_sent_;
+    Clock::time_point next_probe_;
+    Clock::duration   rtt_;            // smoothed DSR round trip
+
+    static Clock::duration LEAN_THRESHOLD() { return std::chrono::milliseconds(250); }
+    static Clock::duration LEAN_HOLD()      { return std::chrono::seconds(3); }
+    static Clock::duration PROBE_INTERVAL() { return std::chrono::seconds(2); }
+    static Clock::duration PROBE_TIMEOUT()  { return std::chrono::seconds(10); }
+
+    bool want_lean() const { return bandwidth_ > 0 && Clock::now() < lean_until_; }
+
+    // Earliest time the next frame may start: the fps cap, the time the link
+    // needs for the bytes already sent, and one round trip.
+    Clock::time_point next_frame_time() const {
+        Clock::time_point t = last_frame_ + frame_interval_;
+        if (bandwidth_ > 0) t = std::max(t, link_free_at_);
+        if (latency_probe_) t = std::max(t, last_frame_ + rtt_);
+        return t;
+    }
+
+    // Accounts a frame of n bytes against the bandwidth budget.  A slow
+    // frame starts (or extends) colourless drawing unless it was the
+    // restyle that switched modes, which would otherwise keep toggling.
+    void charge_link(size_t n, bool restyled = false) {
+        if (bandwidth_ <= 0) return;
+        const Clock::time_point now = Clock::now();
+        link_free_at_ = std::max(now, link_free_at_) + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(static_cast<double>(n) / bandwidth_));
+        if (!restyled && link_free_at_ - now > LEAN_THRESHOLD()) lean_until_ = now + LEAN_HOLD();
+    }
+
+    // Sends a DSR probe when one is due and the output queue is empty, so
+    // the reply time covers the link rather than our own backlog.  A probe
+    // that is never answered turns probing off.
+    void probe_latency() {
+        const Clock::time_point now = Clock::now();
+        if (probe_outstanding_) {
+            if (now - probe_sent_ > PROBE_TIMEOUT()) latency_probe_ = false;
+            return;
+        }
+        if (now < next_probe_ || out_.busy()) return;
+        // frame_buf_ is empty between frames; passing it keeps the
+        // drained body buffer's capacity in circulation.
+        assert(frame_buf_.empty());
+        out_.submit("\033[6n", frame_buf_, "");
+        charge_link(4);
+        probe_outstanding_ = true;
+        probe_sent_ = now;
+        next_probe_ = now + PROBE_INTERVAL();
+    }
+
+    static int millis_until(Clock::time_point t) {
+        const Clock::time_point now = Clock::now();
+        if (t <= now) return 0;
+        // Round up so a wait never ends just short of the deadline.
+        return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            t - now + std::chrono::milliseconds(1) - Clock::duration(1)).count());
+    }
+
+    detail::FrameOutput out_; // non-blocking frame writer
+    std::string frame_buf_;   // frame body under construction, reused
+
+    // Banded rendering (see set_render_threads).  Bands after the first are
+    // encoded into band_out_ and appended to the frame in order.
+    int                      render_threads_;
+    detail::RowWorkers       workers_;
+    std::vector<std::string> band_out_;
+
+    // Number of row bands to split a frame of `rows` rows into.  Bands
+    // shorter than a few rows are not worth a hand-off to another thread.
+    int render_bands(int rows) const {
+        const int MIN_BAND_ROWS = 8;
+        return std::max(1, std::min(workers_.size() + 1, rows / MIN_BAND_ROWS));
+    }
+
+    // Renders when the tab bar or the active page changed since the last
+    // frame, unless that would exceed the frame-rate cap or the previous
+    // frame is still draining; the frame is then left pending and drawn by
+    // the run loop once its slot arrives.
+    void refresh() {
+        if (resize_pending_) return; // the size is settling; draw once it has
+        if (ticks_suspended()) return; // until focus-in
+        if (!frame_dirty()) { frame_pending_ = false; return; }
+        const Clock::time_point now = Clock::now();
+        if (now < next_frame_time() || out_.busy()) { frame_pending_ = true; return; }
+        if (!render()) { frame_pending_ = true; return; } // input first
+        last_frame_ = now;
+        frame_pending_ = false;
+    }
 
     void install_signals() {
 #ifndef _WIN32
@@ -967,13 +2931,19 @@ private:
         sigaction(SIGWINCH, &sa, NULL);
 
         // SIGINT/SIGTERM handler: only async-signal-safe operations permitted.
+        //   • fcntl() — safe.
         //   • ::write() with a literal string — safe.
         //   • tcsetattr() (called inside exit_raw_mode) — safe.
         //   • _Exit() — safe.
         // Notably absent: std::to_string, malloc, stdio — all unsafe in handlers.
         sa.sa_handler = [](int) {
-            // Restore cursor visibility, clear screen, home cursor in one write.
-            static const char seq[] = "\033[?25h\033[2J\033[1;1H";
+            // Clear O_NONBLOCK first: it is shared with stdin and the parent
+            // shell, and the write below should block rather than fail.
+            const int flags = detail::saved_stdout_flags_ref();
+            if (flags >= 0) ::fcntl(STDOUT_FILENO, F_SETFL, flags);
+            // End any open synchronized update, restore cursor visibility and
+            // leave the alternate screen in one write.
+            static const char seq[] = "\033[?2026l\033[?1004l\033[?25h\033[?1049l";
             ::write(STDOUT_FILENO, seq, sizeof(seq) - 1);
             detail::exit_raw_mode();
             _Exit(0);
@@ -986,187 +2956,168 @@ private:
     void handle_key(detail::Key key) {
         if (key == detail::KEY_NONE) return;
 
-        if (key == detail::KEY_QUIT || key == detail::KEY_CTRL_C) {
+        if (key == detail::KEY_CTRL_C) {
             running_ = false;
             return;
         }
+        if (key == detail::KEY_CPR) {
+            if (probe_outstanding_) {
+                // Smooth the samples so one delayed reply does not stall frames.
+                const Clock::duration sample = Clock::now() - probe_sent_;
+                rtt_ = (rtt_ * 3 + sample) / 4;
+                probe_outstanding_ = false;
+            }
+            return;
+        }
         if (key == detail::KEY_RESIZE) {
-            render();
+            // Debounced: the run loop re-reads the size once events stop.
+            resize_pending_  = true;
+            resize_deadline_ = Clock::now() + std::chrono::milliseconds(RESIZE_QUIET_MS);
             return;
         }
-
-        Page& p = pages_[active_tab_];
-        if (p.has_list() && p.list().handle_key(key)) {
-            render();
+        if (goto_active_) {
+            goto_key(key);
+            return;
+        }
+        if (key == detail::KEY_QUIT) {
+            running_ = false;
             return;
         }
 
+        // Keys only mutate state; the run loop renders afterwards.
+        Page& p = pages_[active_tab_];
+        if (p.has_list() && p.list().handle_key(key)) return;
+
         switch (key) {
         case detail::KEY_LEFT:
             if (active_tab_ > 0) {
-                --active_tab_;
+                set_active_tab(active_tab_ - 1);
                 if (active_tab_ < tab_offset_) tab_offset_ = active_tab_;
-                render();
             }
             break;
         case detail::KEY_RIGHT:
-            if (active_tab_ + 1 < pages_.size()) { ++active_tab_; render(); }
+            if (active_tab_ + 1 < pages_.size()) set_active_tab(active_tab_ + 1);
             break;
         case detail::KEY_UP:
             pages_[active_tab_].scroll_up(1);
-            render();
             break;
         case detail::KEY_DOWN: {
-            const detail::TermSize ts = detail::get_terminal_size();
-            const int content_rows = std::max(1, ts.rows - 3);
+            const int content_rows = std::max(1, size_.rows - 3);
             pages_[active_tab_].scroll_down(1, content_rows);
-            render();
             break;
         }
+        case detail::KEY_GOTO:
+            goto_active_ = true;
+            goto_input_.clear();
+            tabs_generation_ = detail::next_generation();
+            break;
         default:
             break;
         }
     }
 
-    void render() {
-        const detail::TermSize ts = detail::get_terminal_size();
-        const int W = ts.cols;
-        const int H = ts.rows;
-
-        // Minimum usable terminal dimensions.
-        const int MIN_COLS = 10;
-        const int MIN_ROWS = 5;
-        if (W < MIN_COLS || H < MIN_ROWS) return;
-
-        // Border layout: │<sp><content><sp>│
-        // Left border(1) + leading space(1) + right border(1) = 3 overhead cols.
-        // Top border row + content rows + bottom border row = H; status embedded in bottom.
-        const int BORDER_OVERHEAD = 3;
-        const int CONTENT_WIDTH   = W - BORDER_OVERHEAD;   // display cols for text
-        const int BLANK_FILL      = W - 2;                 // spaces for empty rows (no borders counted)
-
-        std::string buf;
-        buf.reserve(static_cast<size_t>(W * H) * 8);
+    // Everything the tab bar and the bottom border are drawn from.  Tab
+    // titles and styles are covered by tab_generation().
+    struct ChromeKey {
+        int      cols, rows;
+        size_t   active, offset;
+        uint64_t tabs;
+        int      list_mode; // 0 none, 1 list, 2 multi-select list
+        int      scroll, total;
+
+        bool operator==(const ChromeKey& o) const {
+            return cols == o.cols && rows == o.rows && active == o.active
+                && offset == o.offset && tabs == o.tabs && list_mode == o.list_mode
+                && scroll == o.scroll && total == o.total;
+        }
+    };
+    ChromeKey chrome_key_;
+    bool      chrome_valid_;
+
+    // Interruptible rendering.  render() paints content rows PAINT_CHUNK_ROWS
+    // at a time (per render thread) and checks for pending input between
+    // chunks and before encoding; if a key is waiting, the frame is dropped
+    // so the key is handled first and the next frame reflects it.  Rows
+    // already painted stay valid in the back buffer and are not redone.
+    // After MAX_YIELDS abandoned frames in a row a frame is always
+    // finished, so held-down keys cannot starve the screen.
+    enum { PAINT_CHUNK_ROWS = 16, MAX_YIELDS = 3 };
+    int yields_;
+
+    bool yield_to_input() {
+        if (yields_ >= MAX_YIELDS || !detail::input_pending()) return false;
+        ++yields_;
+        return true;
+    }
 
-        buf += "\033[H\033[0m"; // home cursor, reset attributes
+    // Styles kept in slow-link mode: bold, underline and reverse, no colours.
+    enum : uint32_t { LEAN_STYLE_MASK = 0x7u };
+
+    // Paints the top border with the tab bar (row 0) and the bottom border
+    // with status and scroll hints (row H - 2), adjusting tab_offset_ so the
+    // active tab is visible.
+    void paint_chrome(int W, int H, const Page& p, int scroll, int total) {
+        const int CONTENT_WIDTH = W - 3;
+        const int BLANK_FILL    = W - 2; // columns between the corners
+        const int content_rows  = std::max(1, H - 3);
+        const uint32_t border   = lean_ ? 0 : Style(Color::BrightBlack).pack();
+        const uint32_t mask     = lean_ ? LEAN_STYLE_MASK : ~0u;
+        back_.clear_row(0);
+        back_.clear_row(H - 2);
 
         // Ensure active_tab_ is not left of the visible window (right scroll is
-        // handled by the advancement loop below).
+        // handled by the search below).
         if (active_tab_ < tab_offset_) tab_offset_ = active_tab_;
 
-        // Returns the index of the last tab that fits when rendering from `offset`
-        // within `budget` display columns.  Always returns at least `offset`.
-        auto compute_last_visible = [&](size_t offset, int budget) -> size_t {
-            if (offset >= pages_.size()) return offset;
-            size_t last = offset;
-            int used = static_cast<int>(utf8_display_width(pages_[offset].title())) + 2;
-            for (size_t i = offset + 1; i < pages_.size(); ++i) {
-                const int tab_w = static_cast<int>(utf8_display_width(pages_[i].title())) + 2;
-                // Reserve 2 cols for ' >' indicator if there are tabs after this one.
-                const int right_reserve = (i + 1 < pages_.size()) ? 2 : 0;
-                if (used + 1 + tab_w + right_reserve > budget) break;
-                used += 1 + tab_w; // separator + tab
-                last = i;
+        update_tab_prefix();
+        // A '< ' indicator takes 2 columns once the bar is scrolled.
+        auto budget_at = [&](size_t offset) { return CONTENT_WIDTH - (offset > 0 ? 2 : 0); };
+
+        // Advance tab_offset_ to the smallest offset whose window reaches
+        // active_tab_.  The window's last tab never moves left as the offset
+        // grows, so the offset can be binary-searched.
+        if (last_visible_tab(tab_offset_, budget_at(tab_offset_)) < active_tab_) {
+            size_t lo = tab_offset_ + 1, hi = active_tab_;
+            while (lo < hi) {
+                const size_t mid = lo + (hi - lo) / 2;
+                if (last_visible_tab(mid, budget_at(mid)) >= active_tab_) hi = mid; else lo = mid + 1;
             }
-            return last;
-        };
-
-        // Advance tab_offset_ until active_tab_ is within the visible window.
-        while (true) {
-            const int budget = CONTENT_WIDTH - (tab_offset_ > 0 ? 2 : 0);
-            const size_t lv = compute_last_visible(tab_offset_, budget);
-            if (active_tab_ <= lv) break;
-            ++tab_offset_;
+            tab_offset_ = lo;
         }
 
         // Final visible range for rendering.
-        const int tab_budget = CONTENT_WIDTH - (tab_offset_ > 0 ? 2 : 0);
-        const size_t last_visible = compute_last_visible(tab_offset_, tab_budget);
+        const size_t last_visible = last_visible_tab(tab_offset_, budget_at(tab_offset_));
 
-        // Build tab bar string.
-        std::string tab_str;
-        size_t tab_plain_len = 0;
+        // Top border: corner + dash + tab bar + remaining dashes + corner.
+        int col = back_.put(0, 0, "\xe2\x94\x8c\xe2\x94\x80", border, W);
         if (tab_offset_ > 0) {
-            tab_str += "\033[90m<\033[0m "; // dim '<' + plain space
-            tab_plain_len += 2;
+            col = back_.put(0, col, "<", border, W - col); // dim '<' + plain space
+            col = back_.put(0, col, " ", 0, W - col);
         }
         for (size_t i = tab_offset_; i <= last_visible; ++i) {
-            const std::string& tab_title = pages_[i].title();
-            if (i == active_tab_) {
-                tab_str += pages_[i].tab_style().bold().reversed().begin() + " " + tab_title + " " + Style::reset();
-            } else {
-                tab_str += pages_[i].tab_style().begin() + " " + tab_title + " " + Style::reset();
-            }
-            tab_plain_len += utf8_display_width(tab_title) + 2;
-            if (i < last_visible) {
-                tab_str += "\033[90m|\033[0m";
-                tab_plain_len += 1; // separator
-            }
+            const Style& ts_style = pages_[i].tab_style();
+            const uint32_t st = ((i == active_tab_) ? ts_style.bold().reversed().pack()
+                                                    : ts_style.pack()) & mask;
+            col = back_.put(0, col, " " + pages_[i].title() + " ", st, W - col);
+            if (i < last_visible)
+                col = back_.put(0, col, "|", border, W - col); // separator
         }
         if (last_visible + 1 < pages_.size()) {
-            tab_str += " \033[90m>\033[0m"; // plain space + dim '>'
-            tab_plain_len += 2;
-        }
-
-        // Top border: corner + dash + tab bar + remaining dashes + corner.
-        buf += "\033[90m\xe2\x94\x8c\xe2\x94\x80\033[0m";
-        buf += tab_str;
-        int remaining = CONTENT_WIDTH - static_cast<int>(tab_plain_len);
-        if (remaining > 0) {
-            buf += "\033[90m";
-            for (int i = 0; i < remaining; ++i) buf += "\xe2\x94\x80";
-            buf += "\033[0m";
-        }
-        buf += "\033[90m\xe2\x94\x90\033[0m";
-
-        // Content area.
-        const int content_rows = std::max(1, H - 3); // top border + bottom border + status hint row
-
-        const Page& p = pages_[active_tab_];
-        const int scroll = p.scroll_offset();
-
-        // Combine static page lines with selectable list lines (if present).
-        const std::vector<Text>& static_lines = p.lines();
-        const int n_static = static_cast<int>(static_lines.size());
-
-        std::vector<Text> list_lines;
-        if (p.has_list()) {
-            list_lines = p.list().render(CONTENT_WIDTH - 1); // subtract 1 for list cursor "> "
-        }
-        const int total = n_static + static_cast<int>(list_lines.size());
-
-        for (int row = 0; row < content_rows; ++row) {
-            buf += "\033[";
-            buf += std::to_string(2 + row);
-            buf += ";1H\033[90m\xe2\x94\x82\033[0m"; // row position + left border
-
-            const int line_idx = scroll + row;
-            if (line_idx < total) {
-                const Text& line = (line_idx < n_static)
-                    ? static_lines[static_cast<size_t>(line_idx)]
-                    : list_lines[static_cast<size_t>(line_idx - n_static)];
-                const size_t plain_len = line.length();
-                const int content_width = CONTENT_WIDTH;
-                buf += ' ';
-                buf += line.render(content_width); // truncates overflowing lines
-                if (static_cast<int>(plain_len) < content_width) {
-                    const int pad = content_width - static_cast<int>(plain_len);
-                    buf += std::string(static_cast<size_t>(pad), ' ');
-                }
-            } else {
-                buf += std::string(static_cast<size_t>(BLANK_FILL), ' ');
-            }
-
-            buf += "\033[90m\xe2\x94\x82\033[0m"; // right border
+            col = back_.put(0, col, " ", 0, W - col); // plain space + dim '>'
+            col = back_.put(0, col, ">", border, W - col);
         }
+        col = back_.fill(0, col, W - 1 - col, "\xe2\x94\x80", border);
+        back_.put(0, col, "\xe2\x94\x90", border, W - col);
 
         // Bottom border with status hints and scroll position.
-        buf += "\033[";
-        buf += std::to_string(H - 1);
-        buf += ";1H";
+        const int bottom = H - 2;
 
         const char* status_hint;
-        if (p.has_list() && p.list().is_multi_select())
+        std::string prompt;
+        if (goto_active_) {
+            prompt = " go to tab (number or title): " + goto_input_ + "_ ";
+            status_hint = prompt.c_str();
+        } else if (p.has_list() && p.list().is_multi_select())
             status_hint = " [q] quit  [\xe2\x86\x90\xe2\x86\x92] tabs"
                           "  [\xe2\x86\x91\xe2\x86\x93] select  [Space] toggle  [Enter] confirm ";
         else if (p.has_list())
@@ -1187,21 +3138,219 @@ private:
         int left_dash  = std::max(0, (BLANK_FILL - total_fixed) / 2);
         int right_dash = std::max(0, BLANK_FILL - total_fixed - left_dash);
 
-        buf += "\033[90m\xe2\x94\x94";
-        for (int i = 0; i < left_dash; ++i)  buf += "\xe2\x94\x80";
-        buf += "\033[0m";
-        buf += status_hint;
-        buf += "\033[90m";
-        for (int i = 0; i < right_dash; ++i) buf += "\xe2\x94\x80";
-        if (!scroll_hint.empty()) {
-            buf += "\033[0m";
-            buf += scroll_hint;
-            buf += "\033[90m";
+        col = back_.put(bottom, 0, "\xe2\x94\x94", border, W);
+        col = back_.fill(bottom, col, left_dash, "\xe2\x94\x80", border);
+        col = back_.put(bottom, col, status_hint, 0, W - col);
+        col = back_.fill(bottom, col, right_dash, "\xe2\x94\x80", border);
+        col = back_.put(bottom, col, scroll_hint, 0, W - col);
+        back_.put(bottom, col, "\xe2\x94\x98", border, W - col);
+    }
+
+    // Paints and emits a frame.  Returns false when the frame was abandoned
+    // for pending input; state is left consistent and the next call starts
+    // a fresh frame.
+    bool render() {
+        const int W = size_.cols;
+        const int H = size_.rows;
+
+        // Minimum usable terminal dimensions.
+        const int MIN_COLS = 10;
+        const int MIN_ROWS = 5;
+        if (W < MIN_COLS || H < MIN_ROWS) return true;
+
+        // Border layout: │<sp><content><sp>│
+        // Left border(1) + leading space(1) + right border(1) = 3 overhead cols.
+        // Top border row + content rows + bottom border row = H; status embedded in bottom.
+        const int BORDER_OVERHEAD = 3;
+        const int CONTENT_WIDTH   = W - BORDER_OVERHEAD;   // display cols for text
+
+        // The back buffer keeps the previous frame.  Content rows are
+        // repainted only when the line shown there changed (see row_src_),
+        // the chrome rows only when their ChromeKey did.
+        if (back_.cols() != W || back_.rows() != H) {
+            back_.resize(W, H);
+            front_.resize(W, H);
+            front_valid_ = false;
+            row_src_.assign(static_cast<size_t>(H), static_cast<uint64_t>(ROW_UNPAINTED));
+            chrome_valid_ = false;
+        }
+        // Entering or leaving slow-link mode restyles every row.  The flag
+        // outlives an abandoned frame, so the retry is still charged as a
+        // restyle.
+        if (lean_ != want_lean()) {
+            lean_ = !lean_;
+            restyle_pending_ = true;
+            row_src_.assign(static_cast<size_t>(H), static_cast<uint64_t>(ROW_UNPAINTED));
+            chrome_valid_ = false;
+        }
+        const uint32_t border = lean_ ? 0 : Style(Color::BrightBlack).pack();
+        const uint32_t mask   = lean_ ? LEAN_STYLE_MASK : ~0u;
+
+        // Content area.
+        const int content_rows = std::max(1, H - 3); // top border + bottom border + status hint row
+
+        const Page& p = pages_[active_tab_];
+        const int scroll = p.scroll_offset();
+
+        // Combine static page lines with selectable list lines (if present).
+        const std::vector<Text>& static_lines = p.lines();
+        const int n_static = static_cast<int>(static_lines.size());
+
+        std::vector<Text> list_lines;
+        if (p.has_list()) {
+            list_lines = p.list().render(CONTENT_WIDTH - 1); // subtract 1 for list cursor "> "
+        }
+        const int total = n_static + static_cast<int>(list_lines.size());
+
+        // Content rows are painted in chunks; between chunks, pending input
+        // abandons the frame (see yield_to_input).  Rows are independent of
+        // each other, so with render threads each chunk is split into bands
+        // painted on their own threads.
+        const int chunk_rows = PAINT_CHUNK_ROWS * render_bands(content_rows);
+        for (int chunk = 0; chunk < content_rows; chunk += chunk_rows) {
+            if (chunk > 0 && yield_to_input()) return false;
+            const int chunk_end   = std::min(content_rows, chunk + chunk_rows);
+            const int chunk_bands = render_bands(chunk_end - chunk);
+            workers_.run(chunk_bands, [&](int band) {
+                const int first = chunk + (chunk_end - chunk) * band / chunk_bands;
+                const int last  = chunk + (chunk_end - chunk) * (band + 1) / chunk_bands;
+                for (int row = first; row < last; ++row) {
+                    const int y = 1 + row;
+                    const int line_idx = scroll + row;
+                    const Text* line = nullptr;
+                    if (line_idx < total)
+                        line = (line_idx < n_static)
+                            ? &static_lines[static_cast<size_t>(line_idx)]
+                            : &list_lines[static_cast<size_t>(line_idx - n_static)];
+
+                    // Unchanged line at the same width: the back buffer already holds it.
+                    const uint64_t src = line ? line->revision() : static_cast<uint64_t>(ROW_BLANK);
+                    if (row_src_[static_cast<size_t>(y)] == src) continue;
+                    row_src_[static_cast<size_t>(y)] = src;
+
+                    // Each cell is written once: border, blank gutter, the line
+                    // truncated and padded to CONTENT_WIDTH, border.
+                    back_.fill(y, 0, 1, "\xe2\x94\x82", border); // left border
+                    back_.fill(y, 1, 1, " ", 0);
+                    if (line)
+                        back_.put_line(y, 2, *line, CONTENT_WIDTH, mask);
+                    else
+                        back_.fill(y, 2, CONTENT_WIDTH, " ", 0);
+                    back_.fill(y, W - 1, 1, "\xe2\x94\x82", border); // right border
+                }
+            });
         }
-        buf += "\xe2\x94\x98\033[0m";
-        buf += "\033[J"; // clear from cursor to end of screen
 
-        detail::write_raw(buf);
+        // Tab bar and bottom border depend only on what ChromeKey captures.
+        ChromeKey key;
+        key.cols      = W;
+        key.rows      = H;
+        key.active    = active_tab_;
+        key.offset    = tab_offset_;
+        key.tabs      = tab_generation();
+        key.list_mode = p.has_list() ? (p.list().is_multi_select() ? 2 : 1) : 0;
+        key.scroll    = scroll;
+        key.total     = total;
+        if (!chrome_valid_ || !(key == chrome_key_)) {
+            paint_chrome(W, H, p, scroll, total);
+            key.offset    = tab_offset_; // as adjusted by the layout
+            chrome_key_   = key;
+            chrome_valid_ = true;
+        }
+        if (yield_to_input()) return false;
+        yields_ = 0;
+
+        // Emit only the cells that differ from what the terminal already shows.
+        // After a resize (or on the first frame) the screen contents are
+        // unknown, so clear it and diff against a blank front buffer.
+        // With synchronized output the frame is bracketed by ?2026h/l so the
+        // terminal presents it in one go, however many writes it takes.
+        const bool sync = sync_output_ && caps_.sync_output;
+        std::string& buf = frame_buf_;
+        detail::FrameEncoder enc(buf, W, caps_);
+        bool repaint = false;
+        if (!front_valid_) {
+            repaint = true;
+            front_.clear();
+            front_valid_ = true;
+        } else if (active_tab_ == drawn_tab_index_ && p.content_generation() == drawn_content_) {
+            // Pure scroll of unchanged content: let the terminal shift the
+            // rows inside the borders, then the diff paints only the rows
+            // that scrolled into view.
+            const int delta = scroll - drawn_scroll_;
+            if (delta != 0 && std::abs(delta) < content_rows) {
+                enc.scroll_region(1, content_rows, delta);
+                front_.scroll(1, content_rows, delta);
+            }
+        } else {
+            // Content changed, but rows may only have moved (a tail-style
+            // page appended and scrolled, an item inserted above the view).
+            // Match rows by hash and let the terminal move shifted blocks
+            // when that saves more than it costs, so the diff paints only
+            // rows that are really new.  A false hash match costs bytes, not
+            // correctness: the diff still compares cells.
+            const size_t rows = static_cast<size_t>(content_rows);
+            hash_front_.resize(rows);
+            hash_back_.resize(rows);
+            stay_cost_.resize(rows);
+            ink_cost_.resize(rows);
+            for (int r = 0; r < content_rows; ++r) {
+                const size_t i = static_cast<size_t>(r);
+                hash_front_[i] = front_.row_hash(1 + r);
+                hash_back_[i]  = back_.row_hash(1 + r);
+                stay_cost_[i]  = detail::row_diff_cells(front_, back_, 1 + r);
+                ink_cost_[i]   = detail::row_ink_cells(back_, 1 + r);
+            }
+            const int MIN_GAIN  = 16; // cells; a move costs about that many bytes
+            const int MAX_MOVES = 4;
+            detail::RowShift sh;
+            for (int i = 0; i < MAX_MOVES &&
+                 detail::find_row_shift(hash_front_, hash_back_, stay_cost_, ink_cost_, MIN_GAIN, sh); ++i) {
+                enc.scroll_region(1 + sh.top, 1 + sh.bottom, sh.n);
+                front_.scroll(1 + sh.top, 1 + sh.bottom, sh.n);
+                for (int r = sh.top; r <= sh.bottom; ++r) {
+                    hash_front_[static_cast<size_t>(r)] = front_.row_hash(1 + r);
+                    stay_cost_[static_cast<size_t>(r)]  = detail::row_diff_cells(front_, back_, 1 + r);
+                }
+            }
+        }
+        // Each band after the first starts from an unknown cursor and the
+        // default style, which the band before it ends in, so the bands'
+        // output can simply be concatenated.
+        const int bands = render_bands(H);
+        if (static_cast<int>(band_out_.size()) < bands) band_out_.resize(static_cast<size_t>(bands));
+        workers_.run(bands, [&](int band) {
+            const int first = H * band / bands;
+            const int last  = H * (band + 1) / bands;
+            if (band == 0) {
+                detail::encode_rows(front_, back_, enc, first, last);
+                enc.finish();
+            } else {
+                std::string& out = band_out_[static_cast<size_t>(band)];
+                out.clear();
+                detail::FrameEncoder band_enc(out, W, caps_);
+                detail::encode_rows(front_, back_, band_enc, first, last);
+                band_enc.finish();
+            }
+        });
+        for (int band = 1; band < bands; ++band) buf += band_out_[static_cast<size_t>(band)];
+        if (repaint || !buf.empty()) {
+            static const char* const heads[4] = {
+                "", "\033[?2026h", "\033[0m\033[2J", "\033[?2026h\033[0m\033[2J"
+            };
+            const char* head = heads[(sync ? 1 : 0) + (repaint ? 2 : 0)];
+            const char* tail = sync ? "\033[?2026l" : "";
+            charge_link(std::strlen(head) + buf.size() + std::strlen(tail), restyle_pending_);
+            out_.submit(head, buf, tail);
+        }
+        restyle_pending_ = false;
+
+        drawn_tabs_       = tab_generation();
+        drawn_page_       = p.generation();
+        drawn_content_    = p.content_generation();
+        drawn_tab_index_  = active_tab_;
+        drawn_scroll_     = scroll;
+        return true;
     }
 };
 
@@ -1332,6 +3481,461 @@ private:
     }
 };
 
+// ─── Unicode Width Tables ───────────────────────────────────────────────────
+
+namespace detail {
+
+// WidthClass of every codepoint in planes 0-3 and 14, from Unicode 14.0:
+// general categories Mn, Me and Cf (except U+00AD) and Hangul medial and
+// final jamo are WIDTH_ZERO; East Asian Width W and F, plus unassigned
+// codepoints in the CJK ranges that default to W, are WIDTH_WIDE.
+// Stage 1 maps each 128-codepoint block to a stage 2 block of 32 bytes,
+// four codepoints per byte, lowest bits first.  Identical blocks are shared.
+
+inline const uint8_t* width_stage1() {
+    static const uint8_t table[2080] = {
+          0,   0,   0,   0,   0,   0,   1,   0,   0,   2,   0,   3,   4,   5,   6,   7,
+          8,   9,  10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,
+         24,  25,  26,  27,   0,   0,  28,   0,   0,   0,   0,   0,   0,   0,  29,  30,
+         31,  32,  33,   0,  34,  35,  36,  37,  38,  39,   0,  40,   0,   0,   0,   0,
+         41,  42,   0,   0,   0,   0,  43,  44,   0,   0,   0,  45,  46,  47,  48,  49,
+          0,   0,   0,   0,   0,   0,  50,   0,   0,  51,  52,  53,   0,  54,  55,  56,
+         57,  58,  59,  60,  61,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  62,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  63,   0,   0,  64,  65,   0,   0,
+         66,  67,  68,  69,  70,  71,   0,  72,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  73,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,  55,  55,  55,  55,  74,   0,   0,   0,   0,   0,  75,  52,  76,  77,
+          0,   0,   0,  78,   0,  79,  80,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,  81,  82,   0,   0,   0,   0,  83,   0,   0,  84,  85,  86,
+         87,  88,  89,  90,  91,  92,  93,   0,  94,  95,   0,  96,  97,  98,  99,   0,
+        100,   0, 101, 102, 103, 104,   0,   0, 105, 106, 107, 108,   0, 109,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0, 110,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0, 111, 112,   0,   0,   0,   0,   0,   0,   0, 113, 114,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55, 115,
+         55,  55,  55,  55,  55,  55,  55,  55,  55, 116, 117,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 118,
+         55,  55, 119,  55,  55, 120,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0, 121,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 122,   0,
+          0,   0, 123, 124, 125,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0, 126, 127,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+        128,   0, 112,   0,   0, 129,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0, 130, 131,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+        132, 133,   0, 134, 135,   0, 136, 137, 138, 139, 140, 141, 142, 143,   0, 144,
+          0,   0, 145,  55, 146, 147,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55, 148,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,
+         55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55,  55, 148,
+        149,   0,  27,   1,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    };
+    return table;
+}
+
+inline const uint8_t* width_stage2() {
+    alignas(32) static const uint8_t table[4800] = {
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 0
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 1
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,
+        0x15, 0x00, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 2
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,  // 3
+        0x41, 0x10, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x00, 0x50, 0x55, 0x55, 0x00, 0x00, 0x40, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 4
+        0x55, 0x55, 0x15, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x54, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 5
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x10, 0x00, 0x14, 0x04, 0x50, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x15, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00,  // 6
+        0x00, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x54, 0x55, 0x55, 0x55,  // 7
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x55, 0x55, 0x51,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x10, 0x00, 0x00, 0x01, 0x01, 0x50, 0x55, 0x55, 0x55, 0x55,  // 8
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 9
+        0x55, 0x55, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x54,  // 10
+        0x01, 0x00, 0x54, 0x51, 0x01, 0x00, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54,  // 11
+        0x01, 0x54, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45,
+        0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54,  // 12
+        0x41, 0x15, 0x14, 0x50, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x51, 0x55, 0x55,
+        0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54,  // 13
+        0x01, 0x10, 0x54, 0x51, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00,
+        0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x14,  // 14
+        0x01, 0x54, 0x55, 0x51, 0x55, 0x41, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 15
+        0x54, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x54, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x04,  // 16
+        0x54, 0x05, 0x04, 0x50, 0x55, 0x41, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x14,  // 17
+        0x55, 0x45, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x54,  // 18
+        0x01, 0x54, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 19
+        0x55, 0x55, 0x45, 0x55, 0x05, 0x44, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x00, 0x40, 0x55,  // 20
+        0x55, 0x15, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x00, 0x00, 0x54,  // 21
+        0x55, 0x55, 0x00, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x11, 0x51, 0x55,  // 22
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x00, 0x40,
+        0x00, 0x04, 0x55, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54,  // 23
+        0x55, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x04, 0x00, 0x41, 0x41,  // 24
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x05, 0x54, 0x55, 0x55, 0x55, 0x01, 0x54, 0x55, 0x55,
+        0x45, 0x41, 0x55, 0x51, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 25
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 26
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 27
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 28
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x05, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55,  // 29
+        0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x10, 0x00, 0x50,  // 30
+        0x55, 0x45, 0x01, 0x00, 0x00, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x15, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 31
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55,  // 32
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x40, 0x15, 0x54, 0x55, 0x45, 0x55, 0x01, 0x55,  // 33
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x14, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 34
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x00, 0x40, 0x44, 0x01, 0x00, 0x54, 0x15, 0x00, 0x00, 0x14,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00,  // 35
+        0x00, 0x00, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x04, 0x40, 0x54,  // 36
+        0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x55, 0x55, 0x55,
+        0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x50, 0x10, 0x50, 0x55, 0x55, 0x55, 0x55,  // 37
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x50, 0x11, 0x50, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x05, 0x55, 0x55,  // 38
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 39
+        0x55, 0x55, 0x55, 0x55, 0x40, 0x00, 0x00, 0x00, 0x04, 0x00, 0x54, 0x51, 0x55, 0x54, 0x50, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 40
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x55, 0x55, 0x15, 0x0c, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x40, 0x55, 0x55, 0x55, 0x55,  // 41
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x04, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 42
+        0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xa5, 0x55, 0x55, 0x55, 0x69, 0x55, 0x55, 0x55, 0x55, 0x55,  // 43
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 44
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xa9, 0x56, 0x96, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 45
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x69,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x5a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 46
+        0x55, 0x55, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95,
+        0x55, 0x55, 0x55, 0x55, 0x95, 0x55, 0x55, 0x55, 0x59, 0x55, 0xa5, 0x55, 0x55, 0x55, 0x55, 0x69,  // 47
+        0x55, 0x5a, 0x55, 0x65, 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x65, 0x55, 0xa5, 0x59, 0x65, 0x59,
+        0x55, 0x59, 0xa5, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55,  // 48
+        0x55, 0x55, 0x55, 0x66, 0x95, 0x9a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0xa9, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x56, 0x55, 0x55, 0x95,  // 49
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 50
+        0x55, 0x55, 0x55, 0x55, 0x56, 0x59, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 51
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x50, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 52
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 53
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x9a, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 54
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 55
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 56
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x5a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0x55,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x0a, 0xa0, 0xaa, 0xaa, 0xaa, 0x6a,  // 57
+        0xa9, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0x81, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 58
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+        0x55, 0xa9, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xa9, 0xaa, 0xaa, 0xaa,  // 59
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+        0xaa, 0xaa, 0xaa, 0x6a, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 60
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 61
+        0xaa, 0xaa, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 62
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0xaa, 0xaa, 0xaa, 0x56, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 63
+        0xaa, 0x6a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 64
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x40, 0x00, 0x00, 0x50,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 65
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55,
+        0x45, 0x45, 0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x41, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55,  // 66
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 67
+        0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x50, 0x55, 0x55, 0x15,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x50, 0x55, 0x55, 0x55, 0x55,  // 68
+        0x55, 0x15, 0x00, 0x00, 0x50, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x56,
+        0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x05, 0x50, 0x50,  // 69
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x40, 0x41, 0x41, 0x55, 0x55,  // 70
+        0x15, 0x55, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x04, 0x14, 0x54, 0x05,  // 71
+        0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x45, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 72
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x54, 0x51, 0x55, 0x55, 0x55, 0x55,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00,  // 73
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 74
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x00, 0x00, 0x00, 0xc0, 0xaa, 0xaa, 0x5a, 0x55, 0x00, 0x00, 0x00, 0x00, 0xaa, 0xaa, 0xaa, 0xaa,  // 75
+        0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0xaa, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0xa9, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 76
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 77
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0x6a, 0x55, 0x55, 0x55, 0x55, 0x01, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 78
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 79
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 80
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x40, 0x55,
+        0x01, 0x41, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x40, 0x15,  // 81
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 82
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 83
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x54, 0x55, 0x55, 0x55, 0x55,  // 84
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 85
+        0x55, 0x05, 0x00, 0x00, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x05, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 86
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00,  // 87
+        0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x14, 0x54, 0x55, 0x15,
+        0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x40, 0x41, 0x51,  // 88
+        0x45, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x01, 0x00, 0x54, 0x55, 0x55,  // 89
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55,
+        0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x40,  // 90
+        0x55, 0x55, 0x01, 0x14, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x50, 0x04, 0x55, 0x45,  // 91
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 92
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x15, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x54,  // 93
+        0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x54, 0x00, 0x54, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00,  // 94
+        0x05, 0x44, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x44, 0x15,  // 95
+        0x04, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x50, 0x55, 0x10,  // 96
+        0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x40, 0x11,  // 97
+        0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x51, 0x00, 0x10, 0x55, 0x55,  // 98
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x05, 0x10, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55,  // 99
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x41, 0x55,  // 100
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x44,  // 101
+        0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 102
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x05, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x01, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x14, 0x40,  // 103
+        0x55, 0x15, 0x55, 0x55, 0x01, 0x40, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x05, 0x00, 0x00, 0x40, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 104
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x40, 0x00, 0x10,  // 105
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x04, 0x41, 0x55, 0x55,  // 106
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x40, 0x45, 0x10,  // 107
+        0x00, 0x10, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x50, 0x11, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 108
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 109
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x54, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x54, 0x55,  // 110
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 111
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x54, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x40, 0x55, 0x55,  // 112
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 113
+        0x55, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x15, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 114
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0x54, 0x55, 0x55, 0x5a, 0x55, 0x55, 0x55,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 115
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 116
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x5a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0xaa, 0xaa, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 117
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 118
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0xa9, 0xaa, 0x69,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 119
+        0x55, 0x55, 0x55, 0x55, 0x6a, 0x55, 0x55, 0x55, 0x55, 0xaa, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 120
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x41, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 121
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00, 0x00,  // 122
+        0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 123
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x50, 0x55, 0x15, 0x00, 0x00, 0x00,
+        0x40, 0x01, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x50, 0x55, 0x55, 0x55, 0x55,  // 124
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 125
+        0x05, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x15, 0x00,  // 126
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54, 0x55, 0x51, 0x55, 0x55,
+        0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x01, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,  // 127
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x10, 0x04, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55,  // 128
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55, 0x55,  // 129
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 130
+        0x55, 0x55, 0x55, 0x55, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 131
+        0x55, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 132
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 133
+        0x55, 0x55, 0x55, 0x95, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x65, 0xa9, 0xaa, 0x6a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 134
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xf5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0x6a, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55,  // 135
+        0xaa, 0xaa, 0x56, 0x55, 0x5a, 0x55, 0x55, 0x55, 0xaa, 0x5a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x56, 0x55, 0x55, 0xa9, 0xaa, 0x9a, 0xaa, 0xaa,  // 136
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xa6,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 137
+        0xaa, 0xaa, 0x6a, 0x95, 0xaa, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0x56, 0x56, 0xea, 0xff,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a,  // 138
+        0xa6, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 139
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x96,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x5a,  // 140
+        0x55, 0x55, 0x95, 0x6a, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55, 0x55, 0x65, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x69, 0x55, 0x55, 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 141
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95, 0xaa,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 142
+        0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 143
+        0xaa, 0x5a, 0x55, 0x56, 0x6a, 0xa9, 0x55, 0xa9, 0x55, 0x55, 0x95, 0x56, 0x55, 0xaa, 0xaa, 0x56,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 144
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0x55, 0x56, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0xaa,  // 145
+        0xaa, 0x9a, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,  // 146
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0x56, 0xaa, 0x56,
+        0xaa, 0x6a, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x56, 0xaa, 0xaa, 0x6a, 0x55,  // 147
+        0xaa, 0x5a, 0x55, 0x55, 0xaa, 0xaa, 0x5a, 0x55, 0xaa, 0xaa, 0x55, 0x55, 0xaa, 0x6a, 0x55, 0x55,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,  // 148
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x5a,
+        0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 149
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    };
+    return table;
+}
+
+} // namespace detail
+
 } // namespace termui
 
 #endif // TERMUI_HPP